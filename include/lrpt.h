@@ -246,6 +246,23 @@ typedef enum lrpt_decoder_spacecraft__ {
     LRPT_DECODER_SC_METEORM2_3  /**< Meteor-M2-3 */
 } lrpt_decoder_spacecraft_t;
 
+/** Callback for complete image rows.
+ *
+ * \param apid APID number.
+ * \param pxls Pixels of the first line of rows. Lines follow each other without gaps.
+ * \param line Number of the first line in channel image.
+ * \param n_lines Number of lines.
+ * \param width Width of lines (in px).
+ * \param user_data User data given with callback.
+ */
+typedef void (*lrpt_decoder_rows_cb_t)(
+        uint8_t apid,
+        const uint8_t *pxls,
+        size_t line,
+        size_t n_lines,
+        size_t width,
+        void *user_data);
+
 /** @} */
 
 /*************************************************************************************************/
@@ -1703,6 +1720,24 @@ LRPT_API lrpt_dsp_deinterleaver_t *lrpt_dsp_deinterleaver_init(
 LRPT_API void lrpt_dsp_deinterleaver_deinit(
         lrpt_dsp_deinterleaver_t *deintlv);
 
+/** Set sync detection threshold for deinterleaver.
+ *
+ * Sync words are detected by soft correlation of several consecutive sync words so a few bit
+ * errors in them are tolerated. Threshold is the minimum agreement between soft symbols of sync
+ * words expressed as a percentage. Lower values keep more data on weak signals at the cost of
+ * higher false sync rate. Default value is \c 70.
+ *
+ * \param deintlv Pointer to the deinterleaver object.
+ * \param thresh Sync detection threshold, should be in [50; 100] range.
+ * \param err Pointer to the error object (set to \c NULL if no error reporting is needed).
+ *
+ * \return \c true on successfull threshold change or \c false in case of error.
+ */
+LRPT_API bool lrpt_dsp_deinterleaver_set_sync_thresh(
+        lrpt_dsp_deinterleaver_t *deintlv,
+        uint8_t thresh,
+        lrpt_error_t *err);
+
 /** Resynchronize and deinterleave a stream of QPSK symbols.
  *
  * \param deintlv Pointer to the deinterleaver object.
@@ -2151,6 +2186,25 @@ LRPT_API bool lrpt_decoder_pxls_get(
         size_t n,
         lrpt_error_t *err);
 
+/** Set callback for complete image rows.
+ *
+ * Callback is invoked from #lrpt_decoder_exec() every time a row of MCUs (8 lines) of some
+ * channel is complete, i. e. its rightmost MCU was decoded or decoder moved on to other row of
+ * that channel. Pixels are passed directly from decoder's internal image, so no copies or
+ * polling with #lrpt_decoder_pxls_avail() are needed. If the rightmost MCUs of the last decoded
+ * row are lost, that row is not reported; it is still available with #lrpt_decoder_dump_image().
+ *
+ * \param decoder Pointer to the decoder object.
+ * \param cb Callback function (set to \c NULL to disable callback).
+ * \param user_data User data which will be passed to the callback.
+ *
+ * \warning Pixels are valid only during callback call and they shouldn't be modified!
+ */
+LRPT_API void lrpt_decoder_set_rows_cb(
+        lrpt_decoder_t *decoder,
+        lrpt_decoder_rows_cb_t cb,
+        void *user_data);
+
 /** Current decoder channel image width.
  *
  * \param decoder Pointer to the decoder object.
@@ -75,24 +75,46 @@ static const uint8_t BITOP_BITCNT_TBL[256] = {
 
 /*************************************************************************************************/
 
-/** Return N-th byte in data array.
+/** Load 8 bytes as big-endian word.
  *
- * \param l Bytes array.
- * \param n Index.
+ * \param p Pointer to the data.
  *
- * \return Byte in position \p n inside array \p l.
+ * \return Loaded word.
  */
-static inline uint8_t nth_byte(
-        const uint8_t *l,
-        int8_t n);
+static inline uint64_t load_be64(
+        const uint8_t *p);
+
+/** Store word as 8 big-endian bytes.
+ *
+ * \param p Pointer to the data.
+ * \param x Word to store.
+ */
+static inline void store_be64(
+        uint8_t *p,
+        uint64_t x);
 
 /*************************************************************************************************/
 
-/* nth_byte() */
-static inline uint8_t nth_byte(
-        const uint8_t *l,
-        int8_t n) {
-    return *(l + n);
+/* load_be64() */
+static inline uint64_t load_be64(
+        const uint8_t *p) {
+    uint64_t x = 0;
+
+    /* Compilers turn it into single load and byte swap */
+    for (uint8_t i = 0; i < 8; i++)
+        x = ((x << 8) | p[i]);
+
+    return x;
+}
+
+/*************************************************************************************************/
+
+/* store_be64() */
+static inline void store_be64(
+        uint8_t *p,
+        uint64_t x) {
+    for (uint8_t i = 0; i < 8; i++)
+        p[i] = (x >> (56 - 8 * i));
 }
 
 /*************************************************************************************************/
@@ -113,6 +135,7 @@ void lrpt_decoder_bitop_writer_set(
         lrpt_decoder_bitop_t *w,
         uint8_t *bytes) {
     w->p = bytes;
+    w->len = 0;
 
     w->pos = 0;
     w->cur = 0;
@@ -121,91 +144,100 @@ void lrpt_decoder_bitop_writer_set(
 
 /*************************************************************************************************/
 
-/* lrpt_decoder_bitop_writer_reverse() */
-void lrpt_decoder_bitop_writer_reverse(
+/* lrpt_decoder_bitop_write_n_bits() */
+void lrpt_decoder_bitop_write_n_bits(
         lrpt_decoder_bitop_t *w,
-        uint8_t *l,
-        size_t len) {
-    uint8_t *bytes = w->p;
-    size_t byte_index = w->pos;
-    uint16_t b;
+        uint64_t bits,
+        uint8_t n) {
+    if (n == 0)
+        return;
 
-    l += (len - 1);
+    if (n < 64)
+        bits &= ((UINT64_C(1) << n) - 1);
 
-    if (w->cur_len != 0) {
-        uint8_t close_len = 8 - w->cur_len; /* close_len in [1; 8] range now */
+    /* There are always less than 64 pending bits */
+    const uint8_t space = (64 - w->cur_len);
 
-        if (close_len >= len)
-            close_len = len;
+    if (n < space) {
+        w->cur = ((w->cur << n) | bits);
+        w->cur_len += n;
 
-        b = w->cur;
+        return;
+    }
 
-        for (uint8_t i = 0; i < close_len; i++) {
-            b |= l[0];
-            b <<= 1;
-            l -= 1;
-        }
+    /* Complete the word and store it, the rest of bits become pending */
+    const uint8_t rest = (n - space);
+    const uint64_t word = ((space == 64) ? 0 : (w->cur << space)) | (bits >> rest);
 
-        len -= close_len;
+    store_be64(w->p + w->pos, word);
+    w->pos += 8;
 
-        if ((w->cur_len + close_len) == 8) {
-            b >>= 1;
-            bytes[byte_index] = b;
+    w->cur = (rest == 0) ? 0 : (bits & ((UINT64_C(1) << rest) - 1));
+    w->cur_len = rest;
+}
 
-            byte_index++;
-        }
-        else {
-            w->cur = b;
-            w->cur_len += close_len;
+/*************************************************************************************************/
 
-            return;
-        }
-    }
+/* lrpt_decoder_bitop_write_words() */
+void lrpt_decoder_bitop_write_words(
+        lrpt_decoder_bitop_t *w,
+        const uint64_t *words,
+        size_t n) {
+    for (size_t i = 0; n > 0; i++) {
+        const uint8_t k = (n < 64) ? n : 64;
 
-    const size_t full_bytes = len / 8;
+        lrpt_decoder_bitop_write_n_bits(w, (words[i] >> (64 - k)), k);
+        n -= k;
+    }
+}
 
-    for (size_t i = 0; i < full_bytes; i++) {
-        bytes[byte_index] = (
-                (nth_byte(l, 0) << 7) | (nth_byte(l, -1) << 6) |
-                (nth_byte(l, -2) << 5) | (nth_byte(l, -3) << 4) |
-                (nth_byte(l, -4) << 3) | (nth_byte(l, -5) << 2) |
-                (nth_byte(l, -6) << 1) | nth_byte(l, -7));
+/*************************************************************************************************/
 
-        byte_index++;
-        l -= 8;
+/* lrpt_decoder_bitop_writer_flush() */
+void lrpt_decoder_bitop_writer_flush(
+        lrpt_decoder_bitop_t *w) {
+    while (w->cur_len >= 8) {
+        w->cur_len -= 8;
+        w->p[w->pos] = (w->cur >> w->cur_len);
+        w->pos++;
     }
 
-    len -= 8 * full_bytes; /* len in [0; 7] range now */
+    w->cur &= ((UINT64_C(1) << w->cur_len) - 1);
+}
 
-    b = 0;
+/*************************************************************************************************/
 
-    for (uint8_t i = 0; i < len; i++) {
-        b |= l[0];
-        b <<= 1;
-        l--;
-    }
+/* lrpt_decoder_bitop_reader_set() */
+void lrpt_decoder_bitop_reader_set(
+        lrpt_decoder_bitop_t *b,
+        const uint8_t *bytes,
+        size_t len) {
+    b->p = (uint8_t *)bytes; /* Shared with writer, reader never writes through it */
+    b->len = len;
 
-    w->cur = b;
-    w->pos = byte_index;
-    w->cur_len = len; /* cur_len in [0; 7] range now */
+    b->pos = 0;
+    b->cur = 0;
+    b->cur_len = 0;
 }
 
 /*************************************************************************************************/
 
 /* lrpt_decoder_bitop_peek_n_bits() */
 uint32_t lrpt_decoder_bitop_peek_n_bits(
-        lrpt_decoder_bitop_t *b,
+        const lrpt_decoder_bitop_t *b,
         uint8_t n) {
-    uint32_t result = 0;
-
-    for (uint8_t i = 0; i < n; i++) {
-        const size_t p = (b->pos + i);
-        const uint8_t bit = (b->p[p >> 3] >> (7 - (p & 0x07))) & 0x01;
-
-        result = (result << 1) | bit;
-    }
-
-    return result;
+    const size_t byte_index = (b->pos >> 3);
+    uint64_t word = 0;
+
+    /* Up to 32 bits plus 7 bits of offset always fit into 8 bytes */
+    if ((byte_index + 8) <= b->len)
+        word = load_be64(b->p + byte_index);
+    else
+        for (uint8_t i = 0; i < 8; i++)
+            word = ((word << 8) | (((byte_index + i) < b->len) ? b->p[byte_index + i] : 0));
+
+    /* Shift is split so zero-length peek is well-defined */
+    return (((word << (b->pos & 0x07)) >> 1) >> (63 - n));
 }
 
 /*************************************************************************************************/
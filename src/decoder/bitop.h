@@ -41,10 +41,15 @@
 /** Bit I/O object */
 typedef struct lrpt_decoder_bitop__ {
     uint8_t *p; /**< Data */
+    size_t len; /**< Data length (in bytes), reader returns zero bits past the end */
 
-    size_t pos; /**< Position */
-    uint8_t cur; /**< Data at current position */
-    uint8_t cur_len; /**< Current length */
+    /** Position (in bits for reader and in bytes for writer). Buffered reader counts bits
+     * loaded into the buffer
+     */
+    size_t pos;
+
+    uint64_t cur; /**< Pending bits of writer (right-aligned) or buffered reader (MSB-aligned) */
+    uint8_t cur_len; /**< Number of pending bits */
 } lrpt_decoder_bitop_t;
 
 /*************************************************************************************************/
@@ -67,32 +72,67 @@ void lrpt_decoder_bitop_writer_set(
         lrpt_decoder_bitop_t *w,
         uint8_t *bytes);
 
-/** Reverse bit list order.
+/** Write \p n bits to bit writer, MSB first.
+ *
+ * Bits are collected into 64-bit word which is stored when complete.
+ *
+ * \param w Pointer to the bit writer object.
+ * \param bits Bits to write (right-aligned).
+ * \param n Number of bits to write (up to 64).
+ */
+void lrpt_decoder_bitop_write_n_bits(
+        lrpt_decoder_bitop_t *w,
+        uint64_t bits,
+        uint8_t n);
+
+/** Write \p n packed bits to bit writer.
  *
  * \param w Pointer to the bit writer object.
- * \param l Array of bytes to reverse bits in.
- * \param len Length of given bytes array.
+ * \param words Bits to write, MSB of the first word goes first.
+ * \param n Number of bits to write.
  */
-void lrpt_decoder_bitop_writer_reverse(
+void lrpt_decoder_bitop_write_words(
         lrpt_decoder_bitop_t *w,
-        uint8_t *l,
+        const uint64_t *words,
+        size_t n);
+
+/** Store pending whole bytes of bit writer.
+ *
+ * \param w Pointer to the bit writer object.
+ *
+ * \warning Should be called after the last write, trailing bits of incomplete byte are dropped!
+ */
+void lrpt_decoder_bitop_writer_flush(
+        lrpt_decoder_bitop_t *w);
+
+/** Set initial state for bit reader.
+ *
+ * The same state is used by both plain and buffered readers, but they shouldn't be mixed.
+ *
+ * \param b Pointer to the bit I/O object.
+ * \param bytes Pointer to the data array, it's never modified by reader.
+ * \param len Length of data array.
+ */
+void lrpt_decoder_bitop_reader_set(
+        lrpt_decoder_bitop_t *b,
+        const uint8_t *bytes,
         size_t len);
 
 /** Peek \p n bits from bit I/O object.
  *
  * \param b Pointer to the bit I/O object.
- * \param n Number of bits to peek.
+ * \param n Number of bits to peek (up to 32).
  *
  * \return Specified bits number as 4-byte integer.
  */
 uint32_t lrpt_decoder_bitop_peek_n_bits(
-        lrpt_decoder_bitop_t *b,
+        const lrpt_decoder_bitop_t *b,
         uint8_t n);
 
 /** Fetch \p n bits from bit I/O object.
  *
  * \param b Pointer to the bit I/O object.
- * \param n Number of bits to fetch.
+ * \param n Number of bits to fetch (up to 32).
  *
  * \return Specified bits number as 4-bytes integer.
  */
@@ -111,6 +151,73 @@ void lrpt_decoder_bitop_advance_n_bits(
 
 /*************************************************************************************************/
 
+/* Buffered reader serves streams of short reads, like variable length codes, from the bit buffer
+ * without touching data. It's used in the hot loops, so it's defined right here to be inlined.
+ */
+
+/** Load whole bytes into the buffer of buffered reader until at least 57 bits are buffered.
+ *
+ * Bytes past the end of data are read as zeros. One refill is enough for reads of up to 57 bits
+ * in total.
+ *
+ * \param b Pointer to the bit I/O object.
+ */
+static inline void lrpt_decoder_bitop_buf_refill(
+        lrpt_decoder_bitop_t *b) {
+    while (b->cur_len <= 56) {
+        const size_t byte_index = (b->pos >> 3);
+        const uint64_t byte = (byte_index < b->len) ? b->p[byte_index] : 0;
+
+        b->cur |= (byte << (56 - b->cur_len));
+        b->pos += 8;
+        b->cur_len += 8;
+    }
+}
+
+/** Peek \p n bits from the buffer of buffered reader.
+ *
+ * \param b Pointer to the bit I/O object.
+ * \param n Number of bits to peek, [1; 32] range.
+ *
+ * \return Peeked bits, MSB first.
+ */
+static inline uint32_t lrpt_decoder_bitop_buf_peek_n_bits(
+        const lrpt_decoder_bitop_t *b,
+        uint8_t n) {
+    return (b->cur >> (64 - n));
+}
+
+/** Advance buffered reader by \p n bits.
+ *
+ * \param b Pointer to the bit I/O object.
+ * \param n Number of bits to advance by, should not exceed number of buffered bits.
+ */
+static inline void lrpt_decoder_bitop_buf_advance_n_bits(
+        lrpt_decoder_bitop_t *b,
+        uint8_t n) {
+    b->cur <<= n;
+    b->cur_len -= n;
+}
+
+/** Fetch \p n bits from the buffer of buffered reader.
+ *
+ * \param b Pointer to the bit I/O object.
+ * \param n Number of bits to fetch, [1; 32] range.
+ *
+ * \return Fetched bits, MSB first.
+ */
+static inline uint32_t lrpt_decoder_bitop_buf_pop_n_bits(
+        lrpt_decoder_bitop_t *b,
+        uint8_t n) {
+    const uint32_t result = lrpt_decoder_bitop_buf_peek_n_bits(b, n);
+
+    lrpt_decoder_bitop_buf_advance_n_bits(b, n);
+
+    return result;
+}
+
+/*************************************************************************************************/
+
 #endif
 
 /*************************************************************************************************/
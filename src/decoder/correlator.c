@@ -32,6 +32,7 @@
 
 #include "correlator.h"
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -47,20 +48,36 @@ static const uint64_t CORR_SYNC_WORD_ENC = 0xFCA2B63DB00D9794;
 
 static const uint32_t CORR_LIMIT = 55; /**< Correlation limit */
 
+/** Number of offsets on each side of the soft correlation peak to estimate sidelobes */
+static const int16_t CORR_SOFT_SIDELOBE_SPAN = 128;
+
+/** Per-byte masks for packed distances */
+static const uint64_t CORR_DIST_HI_BITS = 0x8080808080808080;
+
 const uint16_t CORR_IQ_TBL_SIZE = 256;
+const uint16_t CORR_SOFT_TAIL_LEN = CORR_SOFT_SIDELOBE_SPAN + CORR_PATTERN_SIZE;
 
 /*************************************************************************************************/
 
-/** Initialize correlator patterns.
+/** Count set bits in a word.
  *
- * \param corr Pointer to the correlator object.
- * \param n Pattern number.
- * \param p Coded pattern phases.
+ * \param x Word.
+ *
+ * \return Number of set bits.
  */
-static void set_patterns(
-        lrpt_decoder_correlator_t *corr,
-        uint8_t n,
-        uint64_t p);
+static uint8_t popcount_qw(
+        uint64_t x);
+
+/** Calculate packed Hamming distances between hard bits window and all patterns.
+ *
+ * \param dist_tab Pointer to the distance table.
+ * \param window Hard bits window.
+ *
+ * \return Packed distances, one byte per pattern.
+ */
+static inline uint64_t window_dist(
+        const uint64_t *dist_tab,
+        uint64_t window);
 
 /** Rotate symbol.
  *
@@ -101,17 +118,32 @@ static uint64_t flip_iq_qw(
 
 /*************************************************************************************************/
 
-/* set_patterns() */
-static void set_patterns(
-        lrpt_decoder_correlator_t *corr,
-        uint8_t n,
-        uint64_t p) {
-    for (uint8_t i = 0; i < CORR_PATTERN_SIZE; i++) {
-        if ((p >> (CORR_PATTERN_SIZE - i - 1)) & 0x01)
-            corr->patterns[i * CORR_PATTERN_SIZE + n] = 0xFF;
-        else
-            corr->patterns[i * CORR_PATTERN_SIZE + n] = 0;
-    }
+/* popcount_qw() */
+static uint8_t popcount_qw(
+        uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555);
+    x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F;
+
+    return ((x * 0x0101010101010101) >> 56);
+}
+
+/*************************************************************************************************/
+
+/* window_dist() */
+static inline uint64_t window_dist(
+        const uint64_t *dist_tab,
+        uint64_t window) {
+    /* Unrolled by hand, it's the hottest spot of the correlator */
+    return
+        dist_tab[0 * 256 + ((window >> 56) & 0xFF)] +
+        dist_tab[1 * 256 + ((window >> 48) & 0xFF)] +
+        dist_tab[2 * 256 + ((window >> 40) & 0xFF)] +
+        dist_tab[3 * 256 + ((window >> 32) & 0xFF)] +
+        dist_tab[4 * 256 + ((window >> 24) & 0xFF)] +
+        dist_tab[5 * 256 + ((window >> 16) & 0xFF)] +
+        dist_tab[6 * 256 + ((window >> 8) & 0xFF)] +
+        dist_tab[7 * 256 + (window & 0xFF)];
 }
 
 /*************************************************************************************************/
@@ -179,27 +211,28 @@ lrpt_decoder_correlator_t *lrpt_decoder_correlator_init(void) {
 
     /* NULL-init internals for safe deallocation */
     corr->correlation = NULL;
-    corr->tmp_correlation = NULL;
     corr->position = NULL;
 
     corr->patterns = NULL;
+    corr->dist_tab = NULL;
+    corr->soft_patterns = NULL;
     corr->rotate_iq_tab = NULL;
     corr->invert_iq_tab = NULL;
-    corr->corr_tab = NULL;
 
     /* Allocate internals */
     corr->correlation = calloc(CORR_PATTERN_COUNT, sizeof(uint16_t));
-    corr->tmp_correlation = calloc(CORR_PATTERN_COUNT, sizeof(uint16_t));
     corr->position = calloc(CORR_PATTERN_COUNT, sizeof(size_t));
 
-    corr->patterns = calloc(CORR_PATTERN_SIZE * CORR_PATTERN_SIZE, sizeof(uint8_t));
+    corr->patterns = calloc(CORR_PATTERN_COUNT, sizeof(uint64_t));
+    corr->dist_tab = calloc(CORR_PATTERN_COUNT * CORR_IQ_TBL_SIZE, sizeof(uint64_t));
+    corr->soft_patterns = calloc(CORR_PATTERN_COUNT * CORR_PATTERN_SIZE, sizeof(int8_t));
     corr->rotate_iq_tab = calloc(CORR_IQ_TBL_SIZE, sizeof(uint8_t));
     corr->invert_iq_tab = calloc(CORR_IQ_TBL_SIZE, sizeof(uint8_t));
-    corr->corr_tab = calloc(CORR_IQ_TBL_SIZE * CORR_IQ_TBL_SIZE, sizeof(uint8_t));
 
     /* Check for allocation problems */
-    if (!corr->correlation || !corr->tmp_correlation || !corr->position || !corr->patterns ||
-            !corr->rotate_iq_tab || !corr->invert_iq_tab || !corr->corr_tab) {
+    if (!corr->correlation || !corr->position || !corr->patterns || !corr->dist_tab ||
+            !corr->soft_patterns ||
+            !corr->rotate_iq_tab || !corr->invert_iq_tab) {
         lrpt_decoder_correlator_deinit(corr);
 
         return NULL;
@@ -209,17 +242,39 @@ lrpt_decoder_correlator_t *lrpt_decoder_correlator_init(void) {
     for (uint16_t i = 0; i < CORR_IQ_TBL_SIZE; i++) {
         corr->rotate_iq_tab[i] = ((((i & 0x55) ^ 0x55) << 1) | ((i & 0xAA) >> 1));
         corr->invert_iq_tab[i] = (((i & 0x55) << 1) | ((i & 0xAA) >> 1));
-
-        for (uint16_t j = 0; j < CORR_IQ_TBL_SIZE; j++)
-            corr->corr_tab[i * CORR_IQ_TBL_SIZE + j] =
-                (((i > 127) && (j == 0)) || ((i <= 127) && (j == 255))) ? 1 : 0;
     }
 
     for (uint8_t i = 0; i < 4; i++)
-        set_patterns(corr, i, rotate_iq_qw(corr, CORR_SYNC_WORD_ENC, i));
+        corr->patterns[i] = rotate_iq_qw(corr, CORR_SYNC_WORD_ENC, i);
 
     for (uint8_t i = 0; i < 4; i++)
-        set_patterns(corr, i + 4, rotate_iq_qw(corr, flip_iq_qw(corr, CORR_SYNC_WORD_ENC), i));
+        corr->patterns[i + 4] = rotate_iq_qw(corr, flip_iq_qw(corr, CORR_SYNC_WORD_ENC), i);
+
+    /* For every byte of pattern window and every hard bits byte pack Hamming distances to all
+     * patterns into one word, one byte per pattern. Distances are not greater than 64 so sums
+     * over whole window never overflow the bytes
+     */
+    for (uint8_t k = 0; k < CORR_PATTERN_COUNT; k++)
+        for (uint16_t v = 0; v < CORR_IQ_TBL_SIZE; v++) {
+            uint64_t d = 0;
+
+            for (uint8_t j = 0; j < CORR_PATTERN_COUNT; j++) {
+                uint8_t pb = ((corr->patterns[j] >> (56 - 8 * k)) & 0xFF);
+
+                d |= ((uint64_t)popcount_qw(v ^ pb) << (8 * j));
+            }
+
+            corr->dist_tab[k * CORR_IQ_TBL_SIZE + v] = d;
+        }
+
+    /* Set bit corresponds to the non-negative soft symbol */
+    for (uint8_t j = 0; j < CORR_PATTERN_COUNT; j++)
+        for (uint8_t i = 0; i < CORR_PATTERN_SIZE; i++)
+            corr->soft_patterns[j * CORR_PATTERN_SIZE + i] =
+                ((corr->patterns[j] >> (CORR_PATTERN_SIZE - i - 1)) & 0x01) ? 1 : -1;
+
+    corr->soft_correlation = 0;
+    corr->soft_psr = 0;
 
     return corr;
 }
@@ -233,11 +288,11 @@ void lrpt_decoder_correlator_deinit(
         return;
 
     free(corr->correlation);
-    free(corr->tmp_correlation);
     free(corr->position);
 
     free(corr->patterns);
-    free(corr->corr_tab);
+    free(corr->dist_tab);
+    free(corr->soft_patterns);
     free(corr->invert_iq_tab);
     free(corr->rotate_iq_tab);
     free(corr);
@@ -254,27 +309,52 @@ uint8_t lrpt_decoder_correlator_correlate(
     memset(corr->correlation, 0, sizeof(uint16_t) * CORR_PATTERN_COUNT);
     memset(corr->position, 0, sizeof(size_t) * CORR_PATTERN_COUNT);
 
+    /* Soft symbols are sliced to the hard bits once (non-negative symbol is treated as 1) and
+     * shifted through the 64-bit window. Distances to all patterns for the window are just
+     * 8 packed table lookups, one per window byte
+     */
+    const uint64_t *dist_tab = corr->dist_tab;
+    uint64_t window = 0;
+
+    for (uint8_t j = 0; j < (CORR_PATTERN_SIZE - 1); j++)
+        window = (window << 1) | (data[j] >= 0);
+
+    /* Packed distance limits; correlation for pattern j improves only if its distance is not
+     * greater than (63 - correlation[j]). High bit in each byte makes packed compare possible
+     */
+    uint64_t limits = 0;
+
+    for (uint8_t j = 0; j < CORR_PATTERN_COUNT; j++)
+        limits |= ((uint64_t)(CORR_PATTERN_SIZE - 1) << (8 * j));
+
+    limits |= CORR_DIST_HI_BITS;
+
     for (size_t i = 0; i < (len - CORR_PATTERN_SIZE); i++) {
-        memset(corr->tmp_correlation, 0, sizeof(uint16_t) * CORR_PATTERN_COUNT);
+        window = (window << 1) | (data[i + CORR_PATTERN_SIZE - 1] >= 0);
 
-        for (uint8_t j = 0; j < CORR_PATTERN_SIZE; j++) {
-            uint8_t *d = (corr->corr_tab + (uint8_t)data[i + j] * CORR_IQ_TBL_SIZE);
-            uint8_t *p = (corr->patterns + j * CORR_PATTERN_SIZE);
+        uint64_t dist = window_dist(dist_tab, window);
 
-            for (uint8_t k = 0; k < CORR_PATTERN_COUNT; k++)
-                corr->tmp_correlation[k] += d[p[k]];
-        }
+        /* Fast path: no pattern got better correlation */
+        if (!((limits - dist) & CORR_DIST_HI_BITS))
+            continue;
 
-        for (uint8_t j = 0; j < CORR_PATTERN_COUNT; j++)
-            if (corr->tmp_correlation[j] > corr->correlation[j]) {
-                corr->correlation[j] = corr->tmp_correlation[j];
-                corr->tmp_correlation[j] = 0;
+        for (uint8_t j = 0; j < CORR_PATTERN_COUNT; j++) {
+            uint16_t c = (CORR_PATTERN_SIZE - ((dist >> (8 * j)) & 0xFF));
+
+            if (c > corr->correlation[j]) {
+                corr->correlation[j] = c;
                 corr->position[j] = i;
 
                 /* Try to find correlation that exceeds predefined limit */
-                if (corr->correlation[j] > CORR_LIMIT)
+                if (c > CORR_LIMIT)
                     return j;
+
+                /* Update distance limit for this pattern */
+                limits &= ~((uint64_t)0xFF << (8 * j));
+                limits |= ((uint64_t)(CORR_PATTERN_SIZE - 1 - c) << (8 * j));
+                limits |= CORR_DIST_HI_BITS;
             }
+        }
     }
 
     /* In other case find maximum correlation value and return corresponding pattern index */
@@ -292,4 +372,133 @@ uint8_t lrpt_decoder_correlator_correlate(
 
 /*************************************************************************************************/
 
+/* lrpt_decoder_correlator_scan() */
+size_t lrpt_decoder_correlator_scan(
+        const lrpt_decoder_correlator_t *corr,
+        const int8_t *data,
+        size_t len,
+        size_t block,
+        uint16_t min_corr,
+        lrpt_decoder_correlator_cand_t *cands,
+        size_t max_cands) {
+    if ((len < CORR_PATTERN_SIZE) || (block == 0) || (min_corr > CORR_PATTERN_SIZE))
+        return 0;
+
+    const uint64_t *dist_tab = corr->dist_tab;
+    const size_t span = (len - CORR_PATTERN_SIZE + 1);
+
+    size_t n = 0;
+    uint64_t window = 0;
+
+    for (uint8_t j = 0; j < (CORR_PATTERN_SIZE - 1); j++)
+        window = (window << 1) | (data[j] >= 0);
+
+    for (size_t start = 0; (start < span) && (n < max_cands); start += block) {
+        const size_t end = ((span - start) > block) ? (start + block) : span;
+
+        /* Best candidate should have correlation not less than thresh, so distance to any of
+         * patterns should be not greater than (64 - thresh) for it
+         */
+        uint16_t thresh = min_corr;
+        uint64_t limits = 0;
+        bool found = false;
+
+        for (uint8_t j = 0; j < CORR_PATTERN_COUNT; j++)
+            limits |= ((uint64_t)(CORR_PATTERN_SIZE - thresh) << (8 * j));
+
+        limits |= CORR_DIST_HI_BITS;
+
+        for (size_t i = start; i < end; i++) {
+            window = (window << 1) | (data[i + CORR_PATTERN_SIZE - 1] >= 0);
+
+            uint64_t dist = window_dist(dist_tab, window);
+
+            /* Fast path: no pattern is close enough */
+            if (!((limits - dist) & CORR_DIST_HI_BITS))
+                continue;
+
+            for (uint8_t j = 0; j < CORR_PATTERN_COUNT; j++) {
+                uint16_t c = (CORR_PATTERN_SIZE - ((dist >> (8 * j)) & 0xFF));
+
+                if (c < thresh)
+                    continue;
+
+                cands[n].position = i;
+                cands[n].pattern = j;
+                cands[n].correlation = c;
+                found = true;
+
+                /* Only better candidates are interesting from now on */
+                thresh = (c + 1);
+            }
+
+            if (found) {
+                limits = 0;
+
+                for (uint8_t j = 0; j < CORR_PATTERN_COUNT; j++)
+                    limits |= ((uint64_t)(CORR_PATTERN_SIZE - thresh) << (8 * j));
+
+                limits |= CORR_DIST_HI_BITS;
+            }
+        }
+
+        if (found)
+            n++;
+    }
+
+    return n;
+}
+
+/*************************************************************************************************/
+
+/* lrpt_decoder_correlator_soft_correlate() */
+void lrpt_decoder_correlator_soft_correlate(
+        lrpt_decoder_correlator_t *corr,
+        const int8_t *data,
+        uint8_t pattern,
+        int8_t min_corr) {
+    const int8_t *p = (corr->soft_patterns + pattern * CORR_PATTERN_SIZE);
+
+    /* Correlation and symbols magnitude at the peak */
+    int32_t peak = 0;
+    int32_t mag = 0;
+
+    for (uint8_t j = 0; j < CORR_PATTERN_SIZE; j++) {
+        peak += data[j] * p[j];
+        mag += abs(data[j]);
+    }
+
+    corr->soft_correlation = ((mag > 0) && (peak > 0)) ? ((100 * peak) / mag) : 0;
+    corr->soft_psr = 0;
+
+    /* Peak-to-sidelobe ratio is much more expensive, don't calculate it if not needed */
+    if (corr->soft_correlation < min_corr)
+        return;
+
+    /* Sidelobes are taken from the neighbourhood of the peak excluding adjacent offsets */
+    int64_t side = 0;
+    uint16_t n = 0;
+
+    for (int16_t i = -CORR_SOFT_SIDELOBE_SPAN; i <= CORR_SOFT_SIDELOBE_SPAN; i++) {
+        if ((i >= -1) && (i <= 1))
+            continue;
+
+        int32_t c = 0;
+
+        for (uint8_t j = 0; j < CORR_PATTERN_SIZE; j++)
+            c += data[i + j] * p[j];
+
+        side += abs(c);
+        n++;
+    }
+
+    if ((side > 0) && (peak > 0)) {
+        const int64_t psr = ((10 * (int64_t)peak * n) / side);
+
+        corr->soft_psr = (psr > UINT16_MAX) ? UINT16_MAX : psr;
+    }
+}
+
+/*************************************************************************************************/
+
 /** \endcond */
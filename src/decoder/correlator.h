@@ -38,27 +38,42 @@
 
 /*************************************************************************************************/
 
-extern const uint16_t CORR_IQ_TBL_SIZE; /**< Rotational, invertional and correlation tables size */
+extern const uint16_t CORR_IQ_TBL_SIZE; /**< Rotational and invertional tables size */
+extern const uint16_t CORR_SOFT_TAIL_LEN; /**< Symbols read by soft correlation past position */
 
 /*************************************************************************************************/
 
+/** Sync candidate found by bulk correlator scan */
+typedef struct lrpt_decoder_correlator_cand__ {
+    size_t position; /**< Position of sync word in data array */
+    uint8_t pattern; /**< Pattern number (phase of the sync word) */
+    uint16_t correlation; /**< Correlation value */
+} lrpt_decoder_correlator_cand_t;
+
 /** Correlator object */
 typedef struct lrpt_decoder_correlator__ {
     /** @{ */
     /** Correlator internal state arrays */
     uint16_t *correlation;
-    uint16_t *tmp_correlation;
     size_t *position;
     /** @} */
 
-    /** Correlator patterns */
-    uint8_t *patterns;
+    /** Correlator patterns (sync word in all possible phases, MSB first) */
+    uint64_t *patterns;
+
+    /** Packed Hamming distances to the patterns for every byte of the pattern window */
+    uint64_t *dist_tab;
+
+    /** Correlator patterns as +1/-1 soft symbols */
+    int8_t *soft_patterns;
+
+    int8_t soft_correlation; /**< Normalized soft correlation (in percents) */
+    uint16_t soft_psr; /**< Soft peak-to-sidelobe ratio (in tenths) */
 
     /** @{ */
     /** Correlator tables */
     uint8_t *rotate_iq_tab;
     uint8_t *invert_iq_tab;
-    uint8_t *corr_tab;
     /** @} */
 } lrpt_decoder_correlator_t;
 
@@ -90,6 +105,53 @@ uint8_t lrpt_decoder_correlator_correlate(
         const int8_t *data,
         size_t len);
 
+/** Calculate soft correlation for the given pattern at the given position.
+ *
+ * Soft symbols are summed against +1/-1 pattern so symbol confidence is taken into account.
+ * Correlation is normalized by the symbols magnitude, peak-to-sidelobe ratio is the ratio
+ * of correlation to the mean absolute correlation at the neighbouring offsets. Results are
+ * stored in the \c soft_correlation and \c soft_psr fields.
+ *
+ * \param corr Pointer to the correlator object.
+ * \param data Pointer to the expected sync word position in data array.
+ * \param pattern Pattern number.
+ * \param min_corr Minimum normalized correlation. Peak-to-sidelobe ratio isn't calculated
+ * (and is set to \c 0) if correlation is lower.
+ *
+ * \warning \p data should be valid for at least 128 symbols before and #CORR_SOFT_TAIL_LEN
+ * symbols after given position!
+ */
+void lrpt_decoder_correlator_soft_correlate(
+        lrpt_decoder_correlator_t *corr,
+        const int8_t *data,
+        uint8_t pattern,
+        int8_t min_corr);
+
+/** Scan data array for sync candidates.
+ *
+ * Data is split into blocks and every offset is correlated with all patterns once. The best
+ * offset of each block becomes a candidate if its correlation is not less than \p min_corr.
+ * Candidates are sorted by position.
+ *
+ * \param corr Pointer to the correlator object.
+ * \param data Input data array.
+ * \param len Length of data array.
+ * \param block Number of offsets in block.
+ * \param min_corr Minimum correlation value.
+ * \param[out] cands Pointer to the candidates storage.
+ * \param max_cands Maximum number of candidates to store. Scan stops when storage is full.
+ *
+ * \return Number of stored candidates.
+ */
+size_t lrpt_decoder_correlator_scan(
+        const lrpt_decoder_correlator_t *corr,
+        const int8_t *data,
+        size_t len,
+        size_t block,
+        uint16_t min_corr,
+        lrpt_decoder_correlator_cand_t *cands,
+        size_t max_cands);
+
 /*************************************************************************************************/
 
 #endif
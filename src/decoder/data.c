@@ -44,8 +44,10 @@
 
 /* Randomization polynomial. For more information see section "5.6 Randomisation",
  * https://www-cdn.eumetsat.int/files/2020-04/pdf_mo_ds_esa_sy_0048_iss8.pdf
+ *
+ * Sequence is repeated for the whole frame (except sync word) so it can be applied word by word.
  */
-static const uint8_t DATA_PRAND_TBL[255] = {
+static const uint8_t DATA_PRAND_TBL[1020] = {
     0xFF, 0x48, 0x0E, 0xC0, 0x9A, 0x0D, 0x70, 0xBC,
     0x8E, 0x2C, 0x93, 0xAD, 0xA7, 0xB7, 0x46, 0xCE,
     0x5A, 0x97, 0x7D, 0xCC, 0x32, 0xA2, 0xBF, 0x3E,
@@ -77,24 +79,149 @@ static const uint8_t DATA_PRAND_TBL[255] = {
     0xA4, 0x07, 0x60, 0x4D, 0x06, 0xB8, 0x5E, 0x47,
     0x16, 0x49, 0xD6, 0xD3, 0xDB, 0xA3, 0x67, 0x2D,
     0x4B, 0xBE, 0xE6, 0x19, 0x51, 0x5F, 0x9F, 0x05,
-    0x08, 0x78, 0xC4, 0x4A, 0x66, 0xF5, 0x58
+    0x08, 0x78, 0xC4, 0x4A, 0x66, 0xF5, 0x58, 0xFF,
+    0x48, 0x0E, 0xC0, 0x9A, 0x0D, 0x70, 0xBC, 0x8E,
+    0x2C, 0x93, 0xAD, 0xA7, 0xB7, 0x46, 0xCE, 0x5A,
+    0x97, 0x7D, 0xCC, 0x32, 0xA2, 0xBF, 0x3E, 0x0A,
+    0x10, 0xF1, 0x88, 0x94, 0xCD, 0xEA, 0xB1, 0xFE,
+    0x90, 0x1D, 0x81, 0x34, 0x1A, 0xE1, 0x79, 0x1C,
+    0x59, 0x27, 0x5B, 0x4F, 0x6E, 0x8D, 0x9C, 0xB5,
+    0x2E, 0xFB, 0x98, 0x65, 0x45, 0x7E, 0x7C, 0x14,
+    0x21, 0xE3, 0x11, 0x29, 0x9B, 0xD5, 0x63, 0xFD,
+    0x20, 0x3B, 0x02, 0x68, 0x35, 0xC2, 0xF2, 0x38,
+    0xB2, 0x4E, 0xB6, 0x9E, 0xDD, 0x1B, 0x39, 0x6A,
+    0x5D, 0xF7, 0x30, 0xCA, 0x8A, 0xFC, 0xF8, 0x28,
+    0x43, 0xC6, 0x22, 0x53, 0x37, 0xAA, 0xC7, 0xFA,
+    0x40, 0x76, 0x04, 0xD0, 0x6B, 0x85, 0xE4, 0x71,
+    0x64, 0x9D, 0x6D, 0x3D, 0xBA, 0x36, 0x72, 0xD4,
+    0xBB, 0xEE, 0x61, 0x95, 0x15, 0xF9, 0xF0, 0x50,
+    0x87, 0x8C, 0x44, 0xA6, 0x6F, 0x55, 0x8F, 0xF4,
+    0x80, 0xEC, 0x09, 0xA0, 0xD7, 0x0B, 0xC8, 0xE2,
+    0xC9, 0x3A, 0xDA, 0x7B, 0x74, 0x6C, 0xE5, 0xA9,
+    0x77, 0xDC, 0xC3, 0x2A, 0x2B, 0xF3, 0xE0, 0xA1,
+    0x0F, 0x18, 0x89, 0x4C, 0xDE, 0xAB, 0x1F, 0xE9,
+    0x01, 0xD8, 0x13, 0x41, 0xAE, 0x17, 0x91, 0xC5,
+    0x92, 0x75, 0xB4, 0xF6, 0xE8, 0xD9, 0xCB, 0x52,
+    0xEF, 0xB9, 0x86, 0x54, 0x57, 0xE7, 0xC1, 0x42,
+    0x1E, 0x31, 0x12, 0x99, 0xBD, 0x56, 0x3F, 0xD2,
+    0x03, 0xB0, 0x26, 0x83, 0x5C, 0x2F, 0x23, 0x8B,
+    0x24, 0xEB, 0x69, 0xED, 0xD1, 0xB3, 0x96, 0xA5,
+    0xDF, 0x73, 0x0C, 0xA8, 0xAF, 0xCF, 0x82, 0x84,
+    0x3C, 0x62, 0x25, 0x33, 0x7A, 0xAC, 0x7F, 0xA4,
+    0x07, 0x60, 0x4D, 0x06, 0xB8, 0x5E, 0x47, 0x16,
+    0x49, 0xD6, 0xD3, 0xDB, 0xA3, 0x67, 0x2D, 0x4B,
+    0xBE, 0xE6, 0x19, 0x51, 0x5F, 0x9F, 0x05, 0x08,
+    0x78, 0xC4, 0x4A, 0x66, 0xF5, 0x58, 0xFF, 0x48,
+    0x0E, 0xC0, 0x9A, 0x0D, 0x70, 0xBC, 0x8E, 0x2C,
+    0x93, 0xAD, 0xA7, 0xB7, 0x46, 0xCE, 0x5A, 0x97,
+    0x7D, 0xCC, 0x32, 0xA2, 0xBF, 0x3E, 0x0A, 0x10,
+    0xF1, 0x88, 0x94, 0xCD, 0xEA, 0xB1, 0xFE, 0x90,
+    0x1D, 0x81, 0x34, 0x1A, 0xE1, 0x79, 0x1C, 0x59,
+    0x27, 0x5B, 0x4F, 0x6E, 0x8D, 0x9C, 0xB5, 0x2E,
+    0xFB, 0x98, 0x65, 0x45, 0x7E, 0x7C, 0x14, 0x21,
+    0xE3, 0x11, 0x29, 0x9B, 0xD5, 0x63, 0xFD, 0x20,
+    0x3B, 0x02, 0x68, 0x35, 0xC2, 0xF2, 0x38, 0xB2,
+    0x4E, 0xB6, 0x9E, 0xDD, 0x1B, 0x39, 0x6A, 0x5D,
+    0xF7, 0x30, 0xCA, 0x8A, 0xFC, 0xF8, 0x28, 0x43,
+    0xC6, 0x22, 0x53, 0x37, 0xAA, 0xC7, 0xFA, 0x40,
+    0x76, 0x04, 0xD0, 0x6B, 0x85, 0xE4, 0x71, 0x64,
+    0x9D, 0x6D, 0x3D, 0xBA, 0x36, 0x72, 0xD4, 0xBB,
+    0xEE, 0x61, 0x95, 0x15, 0xF9, 0xF0, 0x50, 0x87,
+    0x8C, 0x44, 0xA6, 0x6F, 0x55, 0x8F, 0xF4, 0x80,
+    0xEC, 0x09, 0xA0, 0xD7, 0x0B, 0xC8, 0xE2, 0xC9,
+    0x3A, 0xDA, 0x7B, 0x74, 0x6C, 0xE5, 0xA9, 0x77,
+    0xDC, 0xC3, 0x2A, 0x2B, 0xF3, 0xE0, 0xA1, 0x0F,
+    0x18, 0x89, 0x4C, 0xDE, 0xAB, 0x1F, 0xE9, 0x01,
+    0xD8, 0x13, 0x41, 0xAE, 0x17, 0x91, 0xC5, 0x92,
+    0x75, 0xB4, 0xF6, 0xE8, 0xD9, 0xCB, 0x52, 0xEF,
+    0xB9, 0x86, 0x54, 0x57, 0xE7, 0xC1, 0x42, 0x1E,
+    0x31, 0x12, 0x99, 0xBD, 0x56, 0x3F, 0xD2, 0x03,
+    0xB0, 0x26, 0x83, 0x5C, 0x2F, 0x23, 0x8B, 0x24,
+    0xEB, 0x69, 0xED, 0xD1, 0xB3, 0x96, 0xA5, 0xDF,
+    0x73, 0x0C, 0xA8, 0xAF, 0xCF, 0x82, 0x84, 0x3C,
+    0x62, 0x25, 0x33, 0x7A, 0xAC, 0x7F, 0xA4, 0x07,
+    0x60, 0x4D, 0x06, 0xB8, 0x5E, 0x47, 0x16, 0x49,
+    0xD6, 0xD3, 0xDB, 0xA3, 0x67, 0x2D, 0x4B, 0xBE,
+    0xE6, 0x19, 0x51, 0x5F, 0x9F, 0x05, 0x08, 0x78,
+    0xC4, 0x4A, 0x66, 0xF5, 0x58, 0xFF, 0x48, 0x0E,
+    0xC0, 0x9A, 0x0D, 0x70, 0xBC, 0x8E, 0x2C, 0x93,
+    0xAD, 0xA7, 0xB7, 0x46, 0xCE, 0x5A, 0x97, 0x7D,
+    0xCC, 0x32, 0xA2, 0xBF, 0x3E, 0x0A, 0x10, 0xF1,
+    0x88, 0x94, 0xCD, 0xEA, 0xB1, 0xFE, 0x90, 0x1D,
+    0x81, 0x34, 0x1A, 0xE1, 0x79, 0x1C, 0x59, 0x27,
+    0x5B, 0x4F, 0x6E, 0x8D, 0x9C, 0xB5, 0x2E, 0xFB,
+    0x98, 0x65, 0x45, 0x7E, 0x7C, 0x14, 0x21, 0xE3,
+    0x11, 0x29, 0x9B, 0xD5, 0x63, 0xFD, 0x20, 0x3B,
+    0x02, 0x68, 0x35, 0xC2, 0xF2, 0x38, 0xB2, 0x4E,
+    0xB6, 0x9E, 0xDD, 0x1B, 0x39, 0x6A, 0x5D, 0xF7,
+    0x30, 0xCA, 0x8A, 0xFC, 0xF8, 0x28, 0x43, 0xC6,
+    0x22, 0x53, 0x37, 0xAA, 0xC7, 0xFA, 0x40, 0x76,
+    0x04, 0xD0, 0x6B, 0x85, 0xE4, 0x71, 0x64, 0x9D,
+    0x6D, 0x3D, 0xBA, 0x36, 0x72, 0xD4, 0xBB, 0xEE,
+    0x61, 0x95, 0x15, 0xF9, 0xF0, 0x50, 0x87, 0x8C,
+    0x44, 0xA6, 0x6F, 0x55, 0x8F, 0xF4, 0x80, 0xEC,
+    0x09, 0xA0, 0xD7, 0x0B, 0xC8, 0xE2, 0xC9, 0x3A,
+    0xDA, 0x7B, 0x74, 0x6C, 0xE5, 0xA9, 0x77, 0xDC,
+    0xC3, 0x2A, 0x2B, 0xF3, 0xE0, 0xA1, 0x0F, 0x18,
+    0x89, 0x4C, 0xDE, 0xAB, 0x1F, 0xE9, 0x01, 0xD8,
+    0x13, 0x41, 0xAE, 0x17, 0x91, 0xC5, 0x92, 0x75,
+    0xB4, 0xF6, 0xE8, 0xD9, 0xCB, 0x52, 0xEF, 0xB9,
+    0x86, 0x54, 0x57, 0xE7, 0xC1, 0x42, 0x1E, 0x31,
+    0x12, 0x99, 0xBD, 0x56, 0x3F, 0xD2, 0x03, 0xB0,
+    0x26, 0x83, 0x5C, 0x2F, 0x23, 0x8B, 0x24, 0xEB,
+    0x69, 0xED, 0xD1, 0xB3, 0x96, 0xA5, 0xDF, 0x73,
+    0x0C, 0xA8, 0xAF, 0xCF, 0x82, 0x84, 0x3C, 0x62,
+    0x25, 0x33, 0x7A, 0xAC, 0x7F, 0xA4, 0x07, 0x60,
+    0x4D, 0x06, 0xB8, 0x5E, 0x47, 0x16, 0x49, 0xD6,
+    0xD3, 0xDB, 0xA3, 0x67, 0x2D, 0x4B, 0xBE, 0xE6,
+    0x19, 0x51, 0x5F, 0x9F, 0x05, 0x08, 0x78, 0xC4,
+    0x4A, 0x66, 0xF5, 0x58
+};
+
+static const size_t DATA_PRAND_LEN = 1020; /**< Randomization sequence length */
+
+/** @{ */
+/** Phase ambiguity fix-up for every correlator word: whether soft symbols in pair should be
+ * swapped and which of them should be inverted afterwards
+ */
+static const bool DATA_FIX_SWAP[8] = { false, true, false, true, true, false, true, false };
+static const int8_t DATA_FIX_INV[8][2] = {
+    { 0, 0 }, { 0, -1 }, { -1, -1 }, { -1, 0 },
+    { 0, 0 }, { -1, 0 }, { -1, -1 }, { 0, -1 }
 };
+/** @} */
+
+static const uint8_t DATA_FIX_BLOCK_LEN = 64; /**< Fix-up block length in soft symbols */
 
 static const uint16_t DATA_CORRELATION_MIN = 45; /**< Threshold for correlation */
 
+/** @{ */
+/** Thresholds for soft correlation of the next sync word (in percents and tenths) */
+static const int8_t DATA_SOFT_CORRELATION_MIN = 35;
+static const uint16_t DATA_SOFT_PSR_MIN = 30;
+/** @} */
+
+/** Number of sync words to confirm sync candidate while out of sync */
+static const uint8_t DATA_SYNC_CONFIRM_WORDS = 2;
+
 static const uint32_t DATA_SYNC_WORD = 0x1DFCCF1A; /**< Sync word */
+static const uint8_t DATA_SYNC_WORD_LEN = 64; /**< Sync word length in soft symbols */
 static const uint32_t DATA_SYNC_WORD_FLIP = 0xE20330E5; /**< Sync word, bitflipped */
 
 /*************************************************************************************************/
 
-/** Fix packet.
+/** Copy soft symbols and fix phase ambiguity on the fly.
  *
- * \param data Pointer to the aligned data.
- * \param shift Correlator word.
+ * \param dst Pointer to the aligned data.
+ * \param src Pointer to the input data.
+ * \param len Length of data, should be a multiple of #DATA_FIX_BLOCK_LEN.
+ * \param word Correlator word.
  */
-static void fix_packet(
-        int8_t *data,
-        uint8_t shift);
+static void fix_copy(
+        int8_t *restrict dst,
+        const int8_t *restrict src,
+        size_t len,
+        uint8_t word);
 
 /** Correlate next frame.
  *
@@ -106,16 +233,24 @@ static void do_next_correlate(
         const int8_t *data);
 
 /** Perform full correlation.
+ *
+ * Sync found by the hard correlator is confirmed by the soft correlation of the next sync word
+ * which should be exactly one frame ahead. Frames which fail this check are not worth decoding.
+ * Sync near the end of data can't be confirmed so it's just taken.
  *
  * \param decoder Pointer to the decoder object.
  * \param data Data array.
+ * \param len Length of data array.
+ *
+ * \return \c true if aligned frame should be decoded and \c false otherwise.
  *
  * \warning \p data should contain at least two extra #DECODER_SOFT_FRAME_LEN blocks
  * so correlator will be able to perform full correlation run without violating memory access!
  */
-static void do_full_correlate(
+static bool do_full_correlate(
         lrpt_decoder_t *decoder,
-        const int8_t *data);
+        const int8_t *data,
+        size_t len);
 
 /** Decode frame.
  *
@@ -128,52 +263,44 @@ static bool decode_frame(
 
 /*************************************************************************************************/
 
-/* fix_packet() */
-static void fix_packet(
-        int8_t *data,
-        uint8_t shift) {
-    switch (shift) {
-        case 4:
-            {
-                for (size_t i = 0; i < (DECODER_SOFT_FRAME_LEN / 2); i++) {
-                    /* Swap adjacent elements */
-                    int8_t b = data[i * 2 + 0];
-                    data[i * 2 + 0] = data[i * 2 + 1];
-                    data[i * 2 + 1] = b;
-                }
-            }
-
-            break;
-
-        case 5:
-            {
-                for (size_t i = 0; i < (DECODER_SOFT_FRAME_LEN / 2); i++)
-                    /* Invert odd elements */
-                    data[i * 2 + 0] = -data[i * 2 + 0];
-            }
+/* fix_copy() */
+static void fix_copy(
+        int8_t *restrict dst,
+        const int8_t *restrict src,
+        size_t len,
+        uint8_t word) {
+    /* Correlator word 0 means there is no ambiguity at all */
+    if (word == 0) {
+        memcpy(dst, src, sizeof(int8_t) * len);
+
+        return;
+    }
 
-            break;
+    /* Inversion masks for the whole block. Inversion is done as (x ^ -1) - (-1) so it doesn't
+     * need branches
+     */
+    int8_t inv[64]; /* DATA_FIX_BLOCK_LEN */
 
-        case 6:
-            {
-                for (size_t i = 0; i < (DECODER_SOFT_FRAME_LEN / 2); i++) {
-                    /* Swap and invert adjacent elements */
-                    int8_t b = data[i * 2 + 0];
-                    data[i * 2 + 0] = -data[i * 2 + 1];
-                    data[i * 2 + 1] = -b;
-                }
-            }
+    for (uint8_t i = 0; i < DATA_FIX_BLOCK_LEN; i += 2) {
+        inv[i + 0] = DATA_FIX_INV[word][0];
+        inv[i + 1] = DATA_FIX_INV[word][1];
+    }
 
-            break;
+    /* Data is processed in fixed size blocks so compiler can vectorize it */
+    for (size_t k = 0; k < len; k += DATA_FIX_BLOCK_LEN) {
+        const int8_t *in = (src + k);
+        int8_t *out = (dst + k);
 
-        case 7:
-            {
-                for (size_t i = 0; i < (DECODER_SOFT_FRAME_LEN / 2); i++)
-                    /* Invert even elements */
-                    data[i * 2 + 1] = -data[i * 2 + 1];
+        if (DATA_FIX_SWAP[word]) {
+            for (uint8_t i = 0; i < DATA_FIX_BLOCK_LEN; i += 2) {
+                out[i + 0] = ((in[i + 1] ^ inv[i + 0]) - inv[i + 0]);
+                out[i + 1] = ((in[i + 0] ^ inv[i + 1]) - inv[i + 1]);
             }
-
-            break;
+        }
+        else {
+            for (uint8_t i = 0; i < DATA_FIX_BLOCK_LEN; i++)
+                out[i] = ((in[i] ^ inv[i]) - inv[i]);
+        }
     }
 }
 
@@ -183,21 +310,22 @@ static void fix_packet(
 static void do_next_correlate(
         lrpt_decoder_t *decoder,
         const int8_t *data) {
-    /* Just copy new part of data to the aligned buffer */
-    memcpy(decoder->aligned, (data + decoder->pos), sizeof(int8_t) * DECODER_SOFT_FRAME_LEN);
+    const size_t len = (DECODER_SOFT_FRAME_LEN + VITERBI_FLUSH_SOFT_LEN);
+
+    /* Copy new part of data to the aligned buffer, along with the Viterbi flush symbols */
+    fix_copy(decoder->aligned, (data + decoder->pos), len, decoder->corr_word);
 
     /* Advance decoder position */
     decoder->pos += DECODER_SOFT_FRAME_LEN;
-
-    fix_packet(decoder->aligned, decoder->corr_word);
 }
 
 /*************************************************************************************************/
 
 /* do_full_correlate() */
-static void do_full_correlate(
+static bool do_full_correlate(
         lrpt_decoder_t *decoder,
-        const int8_t *data) {
+        const int8_t *data,
+        size_t len) {
     decoder->corr_word = lrpt_decoder_correlator_correlate(
             decoder->corr, (data + decoder->pos), DECODER_SOFT_FRAME_LEN);
     decoder->corr_pos = decoder->corr->position[decoder->corr_word];
@@ -211,19 +339,40 @@ static void do_full_correlate(
 
         /* Advance decoder position by a quarter of soft frame length */
         decoder->pos += (DECODER_SOFT_FRAME_LEN / 4);
+
+        decoder->corr_confirmed = false;
+
+        return false;
     }
-    else { /* Otherwise we just combine data from two sections into aligned array */
-        memcpy(decoder->aligned,
+    else { /* Otherwise we just copy data starting from sync position into aligned array */
+        fix_copy(decoder->aligned,
                 (data + decoder->pos + decoder->corr_pos),
-                sizeof(int8_t) * (DECODER_SOFT_FRAME_LEN - decoder->corr_pos));
-        memcpy((decoder->aligned + DECODER_SOFT_FRAME_LEN - decoder->corr_pos),
-                (data + decoder->pos + DECODER_SOFT_FRAME_LEN),
-                sizeof(int8_t) * decoder->corr_pos);
+                (DECODER_SOFT_FRAME_LEN + VITERBI_FLUSH_SOFT_LEN),
+                decoder->corr_word);
+
+        /* Check next sync word before position is advanced, if its neighbourhood fits into
+         * data
+         */
+        const size_t next = (decoder->pos + decoder->corr_pos + DECODER_SOFT_FRAME_LEN);
+
+        if ((next + CORR_SOFT_TAIL_LEN) <= len) {
+            lrpt_decoder_correlator_soft_correlate(
+                    decoder->corr,
+                    (data + next),
+                    decoder->corr_word,
+                    DATA_SOFT_CORRELATION_MIN);
+
+            decoder->corr_confirmed =
+                ((decoder->corr->soft_correlation >= DATA_SOFT_CORRELATION_MIN) &&
+                 (decoder->corr->soft_psr >= DATA_SOFT_PSR_MIN));
+        }
+        else
+            decoder->corr_confirmed = true;
 
         /* Advance decoder position */
         decoder->pos += (DECODER_SOFT_FRAME_LEN + decoder->corr_pos);
 
-        fix_packet(decoder->aligned, decoder->corr_word);
+        return decoder->corr_confirmed;
     }
 }
 
@@ -231,7 +380,7 @@ static void do_full_correlate(
 
 static bool decode_frame(
         lrpt_decoder_t *decoder) {
-    lrpt_decoder_viterbi_decode(decoder->vit, decoder->corr, decoder->aligned, decoder->decoded);
+    lrpt_decoder_viterbi_decode(decoder->vit, decoder->aligned, decoder->decoded);
 
     uint32_t tmp =
         (decoder->decoded[3] << 24) +
@@ -244,30 +393,34 @@ static bool decode_frame(
     decoder->sig_q = (100 - lrpt_decoder_viterbi_ber_percent(decoder->vit));
 
     /* You can flip all bits in a packet and get a correct ECC anyway. Check for that case */
+    uint64_t flip = 0;
+
     if (lrpt_decoder_bitop_count(decoder->last_sync ^ DATA_SYNC_WORD_FLIP) <
             lrpt_decoder_bitop_count(decoder->last_sync ^ DATA_SYNC_WORD)) {
-        for (size_t i = 0; i < DECODER_HARD_FRAME_LEN; i++)
-            decoder->decoded[i] ^= 0xFF;
-
-        tmp =
-            (decoder->decoded[3] << 24) +
-            (decoder->decoded[2] << 16) +
-            (decoder->decoded[1] << 8) +
-            decoder->decoded[0];
-        decoder->last_sync = tmp;
+        flip = UINT64_MAX;
+        decoder->last_sync = ~tmp;
     }
 
-    /* 4 is an offset because of sync word */
-    for (size_t i = 0; i < (DECODER_HARD_FRAME_LEN - 4); i++)
-        decoder->decoded[4 + i] ^= DATA_PRAND_TBL[i % 255];
+    /* Flip and derandomize data in a single pass while copying it to the ECC codewords.
+     * 4 is an offset because of sync word
+     */
+    const uint8_t *src = (decoder->decoded + 4);
+    size_t i = 0;
+
+    for (; (i + 8) <= DATA_PRAND_LEN; i += 8) {
+        uint64_t x, prand;
 
-    for (uint8_t i = 0; i < 4; i++) {
-        lrpt_decoder_ecc_deinterleave((decoder->decoded + 4), decoder->ecc_buf, i, 4);
-        decoder->r[i] = lrpt_decoder_ecc_decode(decoder->ecc_buf, 0);
-        lrpt_decoder_ecc_interleave(decoder->ecc_buf, decoder->ecced, i, 4);
+        memcpy(&x, (src + i), sizeof(uint64_t));
+        memcpy(&prand, (DATA_PRAND_TBL + i), sizeof(uint64_t));
+        x ^= (prand ^ flip);
+        memcpy((decoder->ecced + i), &x, sizeof(uint64_t));
     }
 
-    return (decoder->r[0] && decoder->r[1] && decoder->r[2] && decoder->r[3]);
+    for (; i < DATA_PRAND_LEN; i++)
+        decoder->ecced[i] = (src[i] ^ DATA_PRAND_TBL[i] ^ (uint8_t)flip);
+
+    /* Codewords are corrected in place, right in the interleaved data */
+    return lrpt_decoder_ecc_decode(decoder->ecced, decoder->r);
 }
 
 /*************************************************************************************************/
@@ -275,27 +428,99 @@ static bool decode_frame(
 /* lrpt_decoder_data_process_frame() */
 bool lrpt_decoder_data_process_frame(
         lrpt_decoder_t *decoder,
-        const int8_t *data) {
+        const int8_t *data,
+        size_t len) {
     bool ok = false;
+    bool next_failed = false;
+    const uint8_t next_word = decoder->corr_word;
 
-    /* Try to correlate next block */
-    if (decoder->corr_pos == 0) {
+    /* Try to correlate next block. If previous frame wasn't decoded and its sync wasn't
+     * confirmed either there is no reason to expect aligned frame here
+     */
+    if ((decoder->corr_pos == 0) && (decoder->framing_ok || decoder->corr_confirmed)) {
         do_next_correlate(decoder, data);
         ok = decode_frame(decoder);
 
         /* In case of failed decoding attempt jump one frame back in data buffer */
-        if (!ok)
+        if (!ok) {
             decoder->pos -= DECODER_SOFT_FRAME_LEN;
+            next_failed = true;
+        }
     }
 
-    if (!ok) {
-        do_full_correlate(decoder, data);
+    /* Don't waste time on decoding if full correlation doesn't confirm sync. If it has found
+     * sync right where the failed attempt was made the aligned frame is exactly the same so
+     * decoding it again makes no sense
+     */
+    if (!ok && do_full_correlate(decoder, data, len) &&
+            !(next_failed && (decoder->corr_pos == 0) && (decoder->corr_word == next_word)))
         ok = decode_frame(decoder);
-    }
 
     return ok;
 }
 
 /*************************************************************************************************/
 
+/* lrpt_decoder_data_find_sync() */
+bool lrpt_decoder_data_find_sync(
+        lrpt_decoder_t *decoder,
+        const int8_t *data,
+        size_t len,
+        size_t *offset) {
+    /* Best candidates for every quarter of soft frame, just like full correlation does */
+    lrpt_decoder_correlator_cand_t cands[4];
+    size_t scan_len = (DECODER_SOFT_FRAME_LEN + DATA_SYNC_WORD_LEN - 1);
+
+    if (scan_len > len)
+        scan_len = len;
+
+    size_t n = lrpt_decoder_correlator_scan(
+            decoder->corr,
+            data,
+            scan_len,
+            (DECODER_SOFT_FRAME_LEN / 4),
+            DATA_CORRELATION_MIN,
+            cands,
+            4);
+
+    for (size_t i = 0; i < n; i++) {
+        bool ok = true;
+
+        /* Confirm candidate with the next sync words which fit into data. Candidates near
+         * the end of data can't be confirmed at all so they are just taken
+         */
+        for (uint8_t k = 1; k <= DATA_SYNC_CONFIRM_WORDS; k++) {
+            if ((cands[i].position + (k + 1) * DECODER_SOFT_FRAME_LEN) > len)
+                break;
+
+            lrpt_decoder_correlator_soft_correlate(
+                    decoder->corr,
+                    (data + cands[i].position + k * DECODER_SOFT_FRAME_LEN),
+                    cands[i].pattern,
+                    DATA_SOFT_CORRELATION_MIN);
+
+            if ((decoder->corr->soft_correlation < DATA_SOFT_CORRELATION_MIN) ||
+                    (decoder->corr->soft_psr < DATA_SOFT_PSR_MIN)) {
+                ok = false;
+
+                break;
+            }
+        }
+
+        /* Sync is known now, so next frame is taken right at the offset with this pattern */
+        if (ok) {
+            decoder->corr_word = cands[i].pattern;
+            decoder->corr_pos = 0;
+            decoder->corr_confirmed = true;
+            *offset = cands[i].position;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*************************************************************************************************/
+
 /** \endcond */
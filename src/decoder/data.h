@@ -36,6 +36,7 @@
 #include "../../include/lrpt.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /*************************************************************************************************/
@@ -44,12 +45,36 @@
  *
  * \param decoder Pointer to the decoder object.
  * \param data Pointer to the raw data.
+ * \param len Length of raw data (should include at least two extra soft frames).
  *
  * \return \c true on successful frame processing and \c false otherwise.
  */
 bool lrpt_decoder_data_process_frame(
         lrpt_decoder_t *decoder,
-        const int8_t *data);
+        const int8_t *data,
+        size_t len);
+
+/** Check whether data contains sync word worth decoding.
+ *
+ * Offsets within one soft frame are scanned for sync candidates with the hard correlator (the best
+ * one for every quarter of soft frame). Each candidate is confirmed by the soft correlation of
+ * the next sync words, just like #lrpt_decoder_data_process_frame() does after full correlation.
+ * Confirmed candidate's pattern becomes the current correlation word, so the next call to
+ * #lrpt_decoder_data_process_frame() at \p offset decodes the frame without full correlation.
+ *
+ * \param decoder Pointer to the decoder object.
+ * \param data Pointer to the raw data.
+ * \param len Length of raw data (should include at least one extra soft frame).
+ * \param[out] offset Offset of the first confirmed candidate. Contains valid value only if
+ * candidate was found.
+ *
+ * \return \c true if confirmed sync candidate was found and \c false otherwise.
+ */
+bool lrpt_decoder_data_find_sync(
+        lrpt_decoder_t *decoder,
+        const int8_t *data,
+        size_t len,
+        size_t *offset);
 
 /*************************************************************************************************/
 
@@ -38,9 +38,7 @@
 #include "../liblrpt/image.h"
 #include "correlator.h"
 #include "data.h"
-#include "ecc.h"
 #include "jpeg.h"
-#include "huffman.h"
 #include "packet.h"
 #include "viterbi.h"
 
@@ -57,6 +55,9 @@ const size_t DECODER_HARD_FRAME_LEN = DECODER_SOFT_FRAME_LEN / (2 * 8);
 
 static const uint16_t DECODER_PACKET_BUF_LEN = 2048;
 
+/** Initial height of internal image, it grows geometrically as more lines are decoded */
+static const uint16_t DECODER_IMAGE_INIT_HEIGHT = 256;
+
 /*************************************************************************************************/
 
 /* lrpt_decoder_init() */
@@ -77,32 +78,30 @@ lrpt_decoder_t *lrpt_decoder_init(
     /* NULL-init internal objects and arrays for safe deallocation */
     decoder->corr = NULL;
     decoder->vit = NULL;
-    decoder->huff = NULL;
     decoder->jpeg = NULL;
 
     decoder->aligned = NULL;
     decoder->decoded = NULL;
     decoder->ecced = NULL;
-    decoder->ecc_buf = NULL;
     decoder->packet_buf = NULL;
 
     /* Initialize internal objects */
     decoder->corr = lrpt_decoder_correlator_init(); /* Correlator */
     decoder->vit = lrpt_decoder_viterbi_init(); /* Viterbi decoder */
-    decoder->huff = lrpt_decoder_huffman_init(); /* Huffman decoder */
     decoder->jpeg = lrpt_decoder_jpeg_init(); /* JPEG decoder */
-    decoder->image = lrpt_image_alloc(0, 12000, NULL); /* LRPT image object */
+    /* LRPT image object, channels are allocated when APID is seen first */
+    decoder->image = lrpt_image_alloc_sparse(0, DECODER_IMAGE_INIT_HEIGHT, NULL);
 
     /* Allocate internal data arrays */
-    decoder->aligned = calloc(DECODER_SOFT_FRAME_LEN, sizeof(int8_t)); /* Aligned data */
+    /* Aligned data (with Viterbi flush symbols) */
+    decoder->aligned = calloc(DECODER_SOFT_FRAME_LEN + VITERBI_FLUSH_SOFT_LEN, sizeof(int8_t));
     decoder->decoded = calloc(DECODER_HARD_FRAME_LEN, sizeof(uint8_t)); /* Decoded data */
     decoder->ecced = calloc(DECODER_HARD_FRAME_LEN, sizeof(uint8_t)); /* ECCed data */
-    decoder->ecc_buf = calloc(ECC_BUF_LEN, sizeof(uint8_t)); /* ECC buffer */
     decoder->packet_buf = calloc(DECODER_PACKET_BUF_LEN, sizeof(uint8_t)); /* Packet buffer */
 
     /* Check for allocation problems */
-    if (!decoder->corr || !decoder->vit || !decoder->huff || !decoder->jpeg || !decoder->image ||
-            !decoder->aligned || !decoder->decoded || !decoder->ecced || !decoder->ecc_buf ||
+    if (!decoder->corr || !decoder->vit || !decoder->jpeg || !decoder->image ||
+            !decoder->aligned || !decoder->decoded || !decoder->ecced ||
             !decoder->packet_buf) {
         lrpt_decoder_deinit(decoder);
 
@@ -119,11 +118,15 @@ lrpt_decoder_t *lrpt_decoder_init(
     decoder->corr_pos = 0;
     decoder->corr_word = 0;
     decoder->corr_val = 64;
+    decoder->corr_confirmed = true;
 
     /* Initially we have no pixels */
     for (uint8_t i = 0; i < 6; i++)
         decoder->pxls_count[i] = 0;
 
+    decoder->rows_cb = NULL;
+    decoder->rows_cb_data = NULL;
+
     decoder->channel_image_height = 0;
     decoder->channel_image_width = lrpt_decoder_spacecraft_imgwidth(sc);
 
@@ -172,14 +175,12 @@ void lrpt_decoder_deinit(
 
 
     free(decoder->packet_buf);
-    free(decoder->ecc_buf);
     free(decoder->ecced);
     free(decoder->decoded);
     free(decoder->aligned);
 
     lrpt_image_free(decoder->image);
     lrpt_decoder_jpeg_deinit(decoder->jpeg);
-    lrpt_decoder_huffman_deinit(decoder->huff);
     lrpt_decoder_viterbi_deinit(decoder->vit);
     lrpt_decoder_correlator_deinit(decoder->corr);
 
@@ -214,8 +215,28 @@ bool lrpt_decoder_exec(
         /* Point to the next chunk */
         int8_t *chunk = (data->qpsk + i * DECODER_SOFT_FRAME_LEN);
 
+        /* While out of sync jump straight to the next sync candidate, skipping the chunk if
+         * there are no candidates at all. Single scan over chunk is much cheaper than full
+         * correlation attempts at every quarter of it
+         */
+        if (!decoder->framing_ok) {
+            size_t offset;
+
+            if (!lrpt_decoder_data_find_sync(
+                        decoder,
+                        (chunk + decoder->pos),
+                        (2 * data->len - i * DECODER_SOFT_FRAME_LEN - decoder->pos),
+                        &offset))
+                continue;
+
+            decoder->pos += offset;
+        }
+
         while (decoder->pos < DECODER_SOFT_FRAME_LEN) {
-            if (lrpt_decoder_data_process_frame(decoder, chunk)) {
+            if (lrpt_decoder_data_process_frame(
+                        decoder,
+                        chunk,
+                        (2 * data->len - i * DECODER_SOFT_FRAME_LEN))) {
                 lrpt_decoder_packet_parse_cvcdu(decoder);
 
                 decoder->frm_ok_cnt++;
@@ -253,10 +274,6 @@ lrpt_image_t *lrpt_decoder_dump_image(
         return NULL;
     }
 
-    /* Resize internal image to the actual height first */
-    if (!lrpt_image_set_height(decoder->image, decoder->channel_image_height, err))
-        return NULL;
-
     /* Allocate resulting LRPT image object */
     lrpt_image_t *result =
         lrpt_image_alloc(decoder->channel_image_width, decoder->channel_image_height, err);
@@ -269,8 +286,13 @@ lrpt_image_t *lrpt_decoder_dump_image(
         return NULL;
     }
 
-    /* Just copy data from internal image object to the resulting image object */
+    /* Internal image may be higher than actual one, only decoded lines are copied. Absent
+     * channels are left zeroed
+     */
     for (uint8_t i = 0; i < 6; i++) {
+        if (!decoder->image->channels[i])
+            continue;
+
         memcpy(
                 result->channels[i],
                 decoder->image->channels[i],
@@ -407,14 +429,31 @@ bool lrpt_decoder_pxls_get(
         return false;
     }
 
-    /* Just copy pixels */
-    memcpy(pxls, img->channels[apid - 64] + offset, n * sizeof(uint8_t));
+    /* Just copy pixels, APIDs which weren't seen have zero pixels */
+    if (img->channels[apid - 64])
+        memcpy(pxls, img->channels[apid - 64] + offset, n * sizeof(uint8_t));
+    else
+        memset(pxls, 0, n * sizeof(uint8_t));
 
     return true;
 }
 
 /*************************************************************************************************/
 
+/* lrpt_decoder_set_rows_cb() */
+void lrpt_decoder_set_rows_cb(
+        lrpt_decoder_t *decoder,
+        lrpt_decoder_rows_cb_t cb,
+        void *user_data) {
+    if (!decoder)
+        return;
+
+    decoder->rows_cb = cb;
+    decoder->rows_cb_data = user_data;
+}
+
+/*************************************************************************************************/
+
 /* lrpt_decoder_imgwidth() */
 size_t lrpt_decoder_imgwidth(
         const lrpt_decoder_t *decoder) {
@@ -36,7 +36,6 @@
 #include "../../include/lrpt.h"
 #include "correlator.h"
 #include "jpeg.h"
-#include "huffman.h"
 #include "viterbi.h"
 
 #include <stdbool.h>
@@ -59,13 +58,11 @@ struct lrpt_decoder__ {
 
     lrpt_decoder_correlator_t *corr; /**< Correlator */
     lrpt_decoder_viterbi_t *vit; /**< Viterbi decoder */
-    lrpt_decoder_huffman_t *huff; /**< Huffman decoder */
     lrpt_decoder_jpeg_t *jpeg; /**< JPEG decoder */
 
     int8_t *aligned; /**< Aligned data after correlation */
     uint8_t *decoded; /**< Decoded data */
     uint8_t *ecced; /**< ECCed data */
-    uint8_t *ecc_buf; /**< Buffer for ECC processing */
 
     size_t pos; /**< Decoder position */
 
@@ -74,11 +71,18 @@ struct lrpt_decoder__ {
     uint16_t corr_val;
     size_t corr_pos;
     uint8_t corr_word;
+    bool corr_confirmed;
     /** @} */
 
     lrpt_image_t *image; /**< Per-channel image representation for all possible APIDs (64-69) */
     size_t pxls_count[6]; /**< Current pixels count for each APID */
 
+    /** @{ */
+    /** Callback for complete image rows and its user data */
+    lrpt_decoder_rows_cb_t rows_cb;
+    void *rows_cb_data;
+    /** @} */
+
     /** @{ */
     /** Image dimensions */
     size_t channel_image_width, channel_image_height;
@@ -39,7 +39,8 @@
 
 /*************************************************************************************************/
 
-static const uint8_t ECC_ALPHA_TBL[256] = {
+/* Exponents are stored twice so sum of two logarithms doesn't need to be reduced */
+static const uint8_t ECC_ALPHA_TBL[512] = {
     0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
     0x87, 0x89, 0x95, 0xAD, 0xDD, 0x3D, 0x7A, 0xF4,
     0x6F, 0xDE, 0x3B, 0x76, 0xEC, 0x5F, 0xBE, 0xFB,
@@ -71,7 +72,39 @@ static const uint8_t ECC_ALPHA_TBL[256] = {
     0xC8, 0x17, 0x2E, 0x5C, 0xB8, 0xF7, 0x69, 0xD2,
     0x23, 0x46, 0x8C, 0x9F, 0xB9, 0xF5, 0x6D, 0xDA,
     0x33, 0x66, 0xCC, 0x1F, 0x3E, 0x7C, 0xF8, 0x77,
-    0xEE, 0x5B, 0xB6, 0xEB, 0x51, 0xA2, 0xC3, 0x00
+    0xEE, 0x5B, 0xB6, 0xEB, 0x51, 0xA2, 0xC3, 0x01,
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x87,
+    0x89, 0x95, 0xAD, 0xDD, 0x3D, 0x7A, 0xF4, 0x6F,
+    0xDE, 0x3B, 0x76, 0xEC, 0x5F, 0xBE, 0xFB, 0x71,
+    0xE2, 0x43, 0x86, 0x8B, 0x91, 0xA5, 0xCD, 0x1D,
+    0x3A, 0x74, 0xE8, 0x57, 0xAE, 0xDB, 0x31, 0x62,
+    0xC4, 0x0F, 0x1E, 0x3C, 0x78, 0xF0, 0x67, 0xCE,
+    0x1B, 0x36, 0x6C, 0xD8, 0x37, 0x6E, 0xDC, 0x3F,
+    0x7E, 0xFC, 0x7F, 0xFE, 0x7B, 0xF6, 0x6B, 0xD6,
+    0x2B, 0x56, 0xAC, 0xDF, 0x39, 0x72, 0xE4, 0x4F,
+    0x9E, 0xBB, 0xF1, 0x65, 0xCA, 0x13, 0x26, 0x4C,
+    0x98, 0xB7, 0xE9, 0x55, 0xAA, 0xD3, 0x21, 0x42,
+    0x84, 0x8F, 0x99, 0xB5, 0xED, 0x5D, 0xBA, 0xF3,
+    0x61, 0xC2, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60,
+    0xC0, 0x07, 0x0E, 0x1C, 0x38, 0x70, 0xE0, 0x47,
+    0x8E, 0x9B, 0xB1, 0xE5, 0x4D, 0x9A, 0xB3, 0xE1,
+    0x45, 0x8A, 0x93, 0xA1, 0xC5, 0x0D, 0x1A, 0x34,
+    0x68, 0xD0, 0x27, 0x4E, 0x9C, 0xBF, 0xF9, 0x75,
+    0xEA, 0x53, 0xA6, 0xCB, 0x11, 0x22, 0x44, 0x88,
+    0x97, 0xA9, 0xD5, 0x2D, 0x5A, 0xB4, 0xEF, 0x59,
+    0xB2, 0xE3, 0x41, 0x82, 0x83, 0x81, 0x85, 0x8D,
+    0x9D, 0xBD, 0xFD, 0x7D, 0xFA, 0x73, 0xE6, 0x4B,
+    0x96, 0xAB, 0xD1, 0x25, 0x4A, 0x94, 0xAF, 0xD9,
+    0x35, 0x6A, 0xD4, 0x2F, 0x5E, 0xBC, 0xFF, 0x79,
+    0xF2, 0x63, 0xC6, 0x0B, 0x16, 0x2C, 0x58, 0xB0,
+    0xE7, 0x49, 0x92, 0xA3, 0xC1, 0x05, 0x0A, 0x14,
+    0x28, 0x50, 0xA0, 0xC7, 0x09, 0x12, 0x24, 0x48,
+    0x90, 0xA7, 0xC9, 0x15, 0x2A, 0x54, 0xA8, 0xD7,
+    0x29, 0x52, 0xA4, 0xCF, 0x19, 0x32, 0x64, 0xC8,
+    0x17, 0x2E, 0x5C, 0xB8, 0xF7, 0x69, 0xD2, 0x23,
+    0x46, 0x8C, 0x9F, 0xB9, 0xF5, 0x6D, 0xDA, 0x33,
+    0x66, 0xCC, 0x1F, 0x3E, 0x7C, 0xF8, 0x77, 0xEE,
+    0x5B, 0xB6, 0xEB, 0x51, 0xA2, 0xC3, 0x01, 0x02
 };
 
 static const uint8_t ECC_IDX_TBL[256] = {
@@ -109,55 +142,547 @@ static const uint8_t ECC_IDX_TBL[256] = {
     246, 135, 165, 23 , 58 , 163, 60 , 183
 };
 
+/* Multiplication of generator polynomial coefficients (highest degree first, leading one is
+ * omitted) by nibbles: first 16 rows are for low nibble, last 16 ones are for high nibble
+ */
+static const uint8_t ECC_REM_TBL[32][32] = {
+    {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {
+        0x5B, 0x7F, 0x56, 0x10, 0x1E, 0x0D, 0xEB, 0x61,
+        0xA5, 0x08, 0x2A, 0x36, 0x56, 0xAB, 0x20, 0x71,
+        0x20, 0xAB, 0x56, 0x36, 0x2A, 0x08, 0xA5, 0x61,
+        0xEB, 0x0D, 0x1E, 0x10, 0x56, 0x7F, 0x5B, 0x01
+    },
+    {
+        0xB6, 0xFE, 0xAC, 0x20, 0x3C, 0x1A, 0x51, 0xC2,
+        0xCD, 0x10, 0x54, 0x6C, 0xAC, 0xD1, 0x40, 0xE2,
+        0x40, 0xD1, 0xAC, 0x6C, 0x54, 0x10, 0xCD, 0xC2,
+        0x51, 0x1A, 0x3C, 0x20, 0xAC, 0xFE, 0xB6, 0x02
+    },
+    {
+        0xED, 0x81, 0xFA, 0x30, 0x22, 0x17, 0xBA, 0xA3,
+        0x68, 0x18, 0x7E, 0x5A, 0xFA, 0x7A, 0x60, 0x93,
+        0x60, 0x7A, 0xFA, 0x5A, 0x7E, 0x18, 0x68, 0xA3,
+        0xBA, 0x17, 0x22, 0x30, 0xFA, 0x81, 0xED, 0x03
+    },
+    {
+        0xEB, 0x7B, 0xDF, 0x40, 0x78, 0x34, 0xA2, 0x03,
+        0x1D, 0x20, 0xA8, 0xD8, 0xDF, 0x25, 0x80, 0x43,
+        0x80, 0x25, 0xDF, 0xD8, 0xA8, 0x20, 0x1D, 0x03,
+        0xA2, 0x34, 0x78, 0x40, 0xDF, 0x7B, 0xEB, 0x04
+    },
+    {
+        0xB0, 0x04, 0x89, 0x50, 0x66, 0x39, 0x49, 0x62,
+        0xB8, 0x28, 0x82, 0xEE, 0x89, 0x8E, 0xA0, 0x32,
+        0xA0, 0x8E, 0x89, 0xEE, 0x82, 0x28, 0xB8, 0x62,
+        0x49, 0x39, 0x66, 0x50, 0x89, 0x04, 0xB0, 0x05
+    },
+    {
+        0x5D, 0x85, 0x73, 0x60, 0x44, 0x2E, 0xF3, 0xC1,
+        0xD0, 0x30, 0xFC, 0xB4, 0x73, 0xF4, 0xC0, 0xA1,
+        0xC0, 0xF4, 0x73, 0xB4, 0xFC, 0x30, 0xD0, 0xC1,
+        0xF3, 0x2E, 0x44, 0x60, 0x73, 0x85, 0x5D, 0x06
+    },
+    {
+        0x06, 0xFA, 0x25, 0x70, 0x5A, 0x23, 0x18, 0xA0,
+        0x75, 0x38, 0xD6, 0x82, 0x25, 0x5F, 0xE0, 0xD0,
+        0xE0, 0x5F, 0x25, 0x82, 0xD6, 0x38, 0x75, 0xA0,
+        0x18, 0x23, 0x5A, 0x70, 0x25, 0xFA, 0x06, 0x07
+    },
+    {
+        0x51, 0xF6, 0x39, 0x80, 0xF0, 0x68, 0xC3, 0x06,
+        0x3A, 0x40, 0xD7, 0x37, 0x39, 0x4A, 0x87, 0x86,
+        0x87, 0x4A, 0x39, 0x37, 0xD7, 0x40, 0x3A, 0x06,
+        0xC3, 0x68, 0xF0, 0x80, 0x39, 0xF6, 0x51, 0x08
+    },
+    {
+        0x0A, 0x89, 0x6F, 0x90, 0xEE, 0x65, 0x28, 0x67,
+        0x9F, 0x48, 0xFD, 0x01, 0x6F, 0xE1, 0xA7, 0xF7,
+        0xA7, 0xE1, 0x6F, 0x01, 0xFD, 0x48, 0x9F, 0x67,
+        0x28, 0x65, 0xEE, 0x90, 0x6F, 0x89, 0x0A, 0x09
+    },
+    {
+        0xE7, 0x08, 0x95, 0xA0, 0xCC, 0x72, 0x92, 0xC4,
+        0xF7, 0x50, 0x83, 0x5B, 0x95, 0x9B, 0xC7, 0x64,
+        0xC7, 0x9B, 0x95, 0x5B, 0x83, 0x50, 0xF7, 0xC4,
+        0x92, 0x72, 0xCC, 0xA0, 0x95, 0x08, 0xE7, 0x0A
+    },
+    {
+        0xBC, 0x77, 0xC3, 0xB0, 0xD2, 0x7F, 0x79, 0xA5,
+        0x52, 0x58, 0xA9, 0x6D, 0xC3, 0x30, 0xE7, 0x15,
+        0xE7, 0x30, 0xC3, 0x6D, 0xA9, 0x58, 0x52, 0xA5,
+        0x79, 0x7F, 0xD2, 0xB0, 0xC3, 0x77, 0xBC, 0x0B
+    },
+    {
+        0xBA, 0x8D, 0xE6, 0xC0, 0x88, 0x5C, 0x61, 0x05,
+        0x27, 0x60, 0x7F, 0xEF, 0xE6, 0x6F, 0x07, 0xC5,
+        0x07, 0x6F, 0xE6, 0xEF, 0x7F, 0x60, 0x27, 0x05,
+        0x61, 0x5C, 0x88, 0xC0, 0xE6, 0x8D, 0xBA, 0x0C
+    },
+    {
+        0xE1, 0xF2, 0xB0, 0xD0, 0x96, 0x51, 0x8A, 0x64,
+        0x82, 0x68, 0x55, 0xD9, 0xB0, 0xC4, 0x27, 0xB4,
+        0x27, 0xC4, 0xB0, 0xD9, 0x55, 0x68, 0x82, 0x64,
+        0x8A, 0x51, 0x96, 0xD0, 0xB0, 0xF2, 0xE1, 0x0D
+    },
+    {
+        0x0C, 0x73, 0x4A, 0xE0, 0xB4, 0x46, 0x30, 0xC7,
+        0xEA, 0x70, 0x2B, 0x83, 0x4A, 0xBE, 0x47, 0x27,
+        0x47, 0xBE, 0x4A, 0x83, 0x2B, 0x70, 0xEA, 0xC7,
+        0x30, 0x46, 0xB4, 0xE0, 0x4A, 0x73, 0x0C, 0x0E
+    },
+    {
+        0x57, 0x0C, 0x1C, 0xF0, 0xAA, 0x4B, 0xDB, 0xA6,
+        0x4F, 0x78, 0x01, 0xB5, 0x1C, 0x15, 0x67, 0x56,
+        0x67, 0x15, 0x1C, 0xB5, 0x01, 0x78, 0x4F, 0xA6,
+        0xDB, 0x4B, 0xAA, 0xF0, 0x1C, 0x0C, 0x57, 0x0F
+    },
+    {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {
+        0xA2, 0x6B, 0x72, 0x87, 0x67, 0xD0, 0x01, 0x0C,
+        0x74, 0x80, 0x29, 0x6E, 0x72, 0x94, 0x89, 0x8B,
+        0x89, 0x94, 0x72, 0x6E, 0x29, 0x80, 0x74, 0x0C,
+        0x01, 0xD0, 0x67, 0x87, 0x72, 0x6B, 0xA2, 0x10
+    },
+    {
+        0xC3, 0xD6, 0xE4, 0x89, 0xCE, 0x27, 0x02, 0x18,
+        0xE8, 0x87, 0x52, 0xDC, 0xE4, 0xAF, 0x95, 0x91,
+        0x95, 0xAF, 0xE4, 0xDC, 0x52, 0x87, 0xE8, 0x18,
+        0x02, 0x27, 0xCE, 0x89, 0xE4, 0xD6, 0xC3, 0x20
+    },
+    {
+        0x61, 0xBD, 0x96, 0x0E, 0xA9, 0xF7, 0x03, 0x14,
+        0x9C, 0x07, 0x7B, 0xB2, 0x96, 0x3B, 0x1C, 0x1A,
+        0x1C, 0x3B, 0x96, 0xB2, 0x7B, 0x07, 0x9C, 0x14,
+        0x03, 0xF7, 0xA9, 0x0E, 0x96, 0xBD, 0x61, 0x30
+    },
+    {
+        0x01, 0x2B, 0x4F, 0x95, 0x1B, 0x4E, 0x04, 0x30,
+        0x57, 0x89, 0xA4, 0x3F, 0x4F, 0xD9, 0xAD, 0xA5,
+        0xAD, 0xD9, 0x4F, 0x3F, 0xA4, 0x89, 0x57, 0x30,
+        0x04, 0x4E, 0x1B, 0x95, 0x4F, 0x2B, 0x01, 0x40
+    },
+    {
+        0xA3, 0x40, 0x3D, 0x12, 0x7C, 0x9E, 0x05, 0x3C,
+        0x23, 0x09, 0x8D, 0x51, 0x3D, 0x4D, 0x24, 0x2E,
+        0x24, 0x4D, 0x3D, 0x51, 0x8D, 0x09, 0x23, 0x3C,
+        0x05, 0x9E, 0x7C, 0x12, 0x3D, 0x40, 0xA3, 0x50
+    },
+    {
+        0xC2, 0xFD, 0xAB, 0x1C, 0xD5, 0x69, 0x06, 0x28,
+        0xBF, 0x0E, 0xF6, 0xE3, 0xAB, 0x76, 0x38, 0x34,
+        0x38, 0x76, 0xAB, 0xE3, 0xF6, 0x0E, 0xBF, 0x28,
+        0x06, 0x69, 0xD5, 0x1C, 0xAB, 0xFD, 0xC2, 0x60
+    },
+    {
+        0x60, 0x96, 0xD9, 0x9B, 0xB2, 0xB9, 0x07, 0x24,
+        0xCB, 0x8E, 0xDF, 0x8D, 0xD9, 0xE2, 0xB1, 0xBF,
+        0xB1, 0xE2, 0xD9, 0x8D, 0xDF, 0x8E, 0xCB, 0x24,
+        0x07, 0xB9, 0xB2, 0x9B, 0xD9, 0x96, 0x60, 0x70
+    },
+    {
+        0x02, 0x56, 0x9E, 0xAD, 0x36, 0x9C, 0x08, 0x60,
+        0xAE, 0x95, 0xCF, 0x7E, 0x9E, 0x35, 0xDD, 0xCD,
+        0xDD, 0x35, 0x9E, 0x7E, 0xCF, 0x95, 0xAE, 0x60,
+        0x08, 0x9C, 0x36, 0xAD, 0x9E, 0x56, 0x02, 0x80
+    },
+    {
+        0xA0, 0x3D, 0xEC, 0x2A, 0x51, 0x4C, 0x09, 0x6C,
+        0xDA, 0x15, 0xE6, 0x10, 0xEC, 0xA1, 0x54, 0x46,
+        0x54, 0xA1, 0xEC, 0x10, 0xE6, 0x15, 0xDA, 0x6C,
+        0x09, 0x4C, 0x51, 0x2A, 0xEC, 0x3D, 0xA0, 0x90
+    },
+    {
+        0xC1, 0x80, 0x7A, 0x24, 0xF8, 0xBB, 0x0A, 0x78,
+        0x46, 0x12, 0x9D, 0xA2, 0x7A, 0x9A, 0x48, 0x5C,
+        0x48, 0x9A, 0x7A, 0xA2, 0x9D, 0x12, 0x46, 0x78,
+        0x0A, 0xBB, 0xF8, 0x24, 0x7A, 0x80, 0xC1, 0xA0
+    },
+    {
+        0x63, 0xEB, 0x08, 0xA3, 0x9F, 0x6B, 0x0B, 0x74,
+        0x32, 0x92, 0xB4, 0xCC, 0x08, 0x0E, 0xC1, 0xD7,
+        0xC1, 0x0E, 0x08, 0xCC, 0xB4, 0x92, 0x32, 0x74,
+        0x0B, 0x6B, 0x9F, 0xA3, 0x08, 0xEB, 0x63, 0xB0
+    },
+    {
+        0x03, 0x7D, 0xD1, 0x38, 0x2D, 0xD2, 0x0C, 0x50,
+        0xF9, 0x1C, 0x6B, 0x41, 0xD1, 0xEC, 0x70, 0x68,
+        0x70, 0xEC, 0xD1, 0x41, 0x6B, 0x1C, 0xF9, 0x50,
+        0x0C, 0xD2, 0x2D, 0x38, 0xD1, 0x7D, 0x03, 0xC0
+    },
+    {
+        0xA1, 0x16, 0xA3, 0xBF, 0x4A, 0x02, 0x0D, 0x5C,
+        0x8D, 0x9C, 0x42, 0x2F, 0xA3, 0x78, 0xF9, 0xE3,
+        0xF9, 0x78, 0xA3, 0x2F, 0x42, 0x9C, 0x8D, 0x5C,
+        0x0D, 0x02, 0x4A, 0xBF, 0xA3, 0x16, 0xA1, 0xD0
+    },
+    {
+        0xC0, 0xAB, 0x35, 0xB1, 0xE3, 0xF5, 0x0E, 0x48,
+        0x11, 0x9B, 0x39, 0x9D, 0x35, 0x43, 0xE5, 0xF9,
+        0xE5, 0x43, 0x35, 0x9D, 0x39, 0x9B, 0x11, 0x48,
+        0x0E, 0xF5, 0xE3, 0xB1, 0x35, 0xAB, 0xC0, 0xE0
+    },
+    {
+        0x62, 0xC0, 0x47, 0x36, 0x84, 0x25, 0x0F, 0x44,
+        0x65, 0x1B, 0x10, 0xF3, 0x47, 0xD7, 0x6C, 0x72,
+        0x6C, 0xD7, 0x47, 0xF3, 0x10, 0x1B, 0x65, 0x44,
+        0x0F, 0x25, 0x84, 0x36, 0x47, 0xC0, 0x62, 0xF0
+    }
+};
+
+/* Multiplication by syndrome roots split by nibbles: first 16 entries are products of the root
+ * and low nibble, last 16 ones are products of the root and high nibble
+ */
+static const uint8_t ECC_SYN_MUL_TBL[32][32] = {
+    {
+        0x00, 0x15, 0x2A, 0x3F, 0x54, 0x41, 0x7E, 0x6B,
+        0xA8, 0xBD, 0x82, 0x97, 0xFC, 0xE9, 0xD6, 0xC3,
+        0x00, 0xD7, 0x29, 0xFE, 0x52, 0x85, 0x7B, 0xAC,
+        0xA4, 0x73, 0x8D, 0x5A, 0xF6, 0x21, 0xDF, 0x08
+    },
+    {
+        0x00, 0x64, 0xC8, 0xAC, 0x17, 0x73, 0xDF, 0xBB,
+        0x2E, 0x4A, 0xE6, 0x82, 0x39, 0x5D, 0xF1, 0x95,
+        0x00, 0x5C, 0xB8, 0xE4, 0xF7, 0xAB, 0x4F, 0x13,
+        0x69, 0x35, 0xD1, 0x8D, 0x9E, 0xC2, 0x26, 0x7A
+    },
+    {
+        0x00, 0x8C, 0x9F, 0x13, 0xB9, 0x35, 0x26, 0xAA,
+        0xF5, 0x79, 0x6A, 0xE6, 0x4C, 0xC0, 0xD3, 0x5F,
+        0x00, 0x6D, 0xDA, 0xB7, 0x33, 0x5E, 0xE9, 0x84,
+        0x66, 0x0B, 0xBC, 0xD1, 0x55, 0x38, 0x8F, 0xE2
+    },
+    {
+        0x00, 0x7C, 0xF8, 0x84, 0x77, 0x0B, 0x8F, 0xF3,
+        0xEE, 0x92, 0x16, 0x6A, 0x99, 0xE5, 0x61, 0x1D,
+        0x00, 0x5B, 0xB6, 0xED, 0xEB, 0xB0, 0x5D, 0x06,
+        0x51, 0x0A, 0xE7, 0xBC, 0xBA, 0xE1, 0x0C, 0x57
+    },
+    {
+        0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E,
+        0x10, 0x12, 0x14, 0x16, 0x18, 0x1A, 0x1C, 0x1E,
+        0x00, 0x20, 0x40, 0x60, 0x80, 0xA0, 0xC0, 0xE0,
+        0x87, 0xA7, 0xC7, 0xE7, 0x07, 0x27, 0x47, 0x67
+    },
+    {
+        0x00, 0xDD, 0x3D, 0xE0, 0x7A, 0xA7, 0x47, 0x9A,
+        0xF4, 0x29, 0xC9, 0x14, 0x8E, 0x53, 0xB3, 0x6E,
+        0x00, 0x6F, 0xDE, 0xB1, 0x3B, 0x54, 0xE5, 0x8A,
+        0x76, 0x19, 0xA8, 0xC7, 0x4D, 0x22, 0x93, 0xFC
+    },
+    {
+        0x00, 0xFB, 0x71, 0x8A, 0xE2, 0x19, 0x93, 0x68,
+        0x43, 0xB8, 0x32, 0xC9, 0xA1, 0x5A, 0xD0, 0x2B,
+        0x00, 0x86, 0x8B, 0x0D, 0x91, 0x17, 0x1A, 0x9C,
+        0xA5, 0x23, 0x2E, 0xA8, 0x34, 0xB2, 0xBF, 0x39
+    },
+    {
+        0x00, 0x74, 0xE8, 0x9C, 0x57, 0x23, 0xBF, 0xCB,
+        0xAE, 0xDA, 0x46, 0x32, 0xF9, 0x8D, 0x11, 0x65,
+        0x00, 0xDB, 0x31, 0xEA, 0x62, 0xB9, 0x53, 0x88,
+        0xC4, 0x1F, 0xF5, 0x2E, 0xA6, 0x7D, 0x97, 0x4C
+    },
+    {
+        0x00, 0x78, 0xF0, 0x88, 0x67, 0x1F, 0x97, 0xEF,
+        0xCE, 0xB6, 0x3E, 0x46, 0xA9, 0xD1, 0x59, 0x21,
+        0x00, 0x1B, 0x36, 0x2D, 0x6C, 0x77, 0x5A, 0x41,
+        0xD8, 0xC3, 0xEE, 0xF5, 0xB4, 0xAF, 0x82, 0x99
+    },
+    {
+        0x00, 0x3F, 0x7E, 0x41, 0xFC, 0xC3, 0x82, 0xBD,
+        0x7F, 0x40, 0x01, 0x3E, 0x83, 0xBC, 0xFD, 0xC2,
+        0x00, 0xFE, 0x7B, 0x85, 0xF6, 0x08, 0x8D, 0x73,
+        0x6B, 0x95, 0x10, 0xEE, 0x9D, 0x63, 0xE6, 0x18
+    },
+    {
+        0x00, 0xAC, 0xDF, 0x73, 0x39, 0x95, 0xE6, 0x4A,
+        0x72, 0xDE, 0xAD, 0x01, 0x4B, 0xE7, 0x94, 0x38,
+        0x00, 0xE4, 0x4F, 0xAB, 0x9E, 0x7A, 0xD1, 0x35,
+        0xBB, 0x5F, 0xF4, 0x10, 0x25, 0xC1, 0x6A, 0x8E
+    },
+    {
+        0x00, 0x13, 0x26, 0x35, 0x4C, 0x5F, 0x6A, 0x79,
+        0x98, 0x8B, 0xBE, 0xAD, 0xD4, 0xC7, 0xF2, 0xE1,
+        0x00, 0xB7, 0xE9, 0x5E, 0x55, 0xE2, 0xBC, 0x0B,
+        0xAA, 0x1D, 0x43, 0xF4, 0xFF, 0x48, 0x16, 0xA1
+    },
+    {
+        0x00, 0x84, 0x8F, 0x0B, 0x99, 0x1D, 0x16, 0x92,
+        0xB5, 0x31, 0x3A, 0xBE, 0x2C, 0xA8, 0xA3, 0x27,
+        0x00, 0xED, 0x5D, 0xB0, 0xBA, 0x57, 0xE7, 0x0A,
+        0xF3, 0x1E, 0xAE, 0x43, 0x49, 0xA4, 0x14, 0xF9
+    },
+    {
+        0x00, 0x06, 0x0C, 0x0A, 0x18, 0x1E, 0x14, 0x12,
+        0x30, 0x36, 0x3C, 0x3A, 0x28, 0x2E, 0x24, 0x22,
+        0x00, 0x60, 0xC0, 0xA0, 0x07, 0x67, 0xC7, 0xA7,
+        0x0E, 0x6E, 0xCE, 0xAE, 0x09, 0x69, 0xC9, 0xA9
+    },
+    {
+        0x00, 0xE0, 0x47, 0xA7, 0x8E, 0x6E, 0xC9, 0x29,
+        0x9B, 0x7B, 0xDC, 0x3C, 0x15, 0xF5, 0x52, 0xB2,
+        0x00, 0xB1, 0xE5, 0x54, 0x4D, 0xFC, 0xA8, 0x19,
+        0x9A, 0x2B, 0x7F, 0xCE, 0xD7, 0x66, 0x32, 0x83
+    },
+    {
+        0x00, 0x8A, 0x93, 0x19, 0xA1, 0x2B, 0x32, 0xB8,
+        0xC5, 0x4F, 0x56, 0xDC, 0x64, 0xEE, 0xF7, 0x7D,
+        0x00, 0x0D, 0x1A, 0x17, 0x34, 0x39, 0x2E, 0x23,
+        0x68, 0x65, 0x72, 0x7F, 0x5C, 0x51, 0x46, 0x4B
+    },
+    {
+        0x00, 0x9C, 0xBF, 0x23, 0xF9, 0x65, 0x46, 0xDA,
+        0x75, 0xE9, 0xCA, 0x56, 0x8C, 0x10, 0x33, 0xAF,
+        0x00, 0xEA, 0x53, 0xB9, 0xA6, 0x4C, 0xF5, 0x1F,
+        0xCB, 0x21, 0x98, 0x72, 0x6D, 0x87, 0x3E, 0xD4
+    },
+    {
+        0x00, 0x88, 0x97, 0x1F, 0xA9, 0x21, 0x3E, 0xB6,
+        0xD5, 0x5D, 0x42, 0xCA, 0x7C, 0xF4, 0xEB, 0x63,
+        0x00, 0x2D, 0x5A, 0x77, 0xB4, 0x99, 0xEE, 0xC3,
+        0xEF, 0xC2, 0xB5, 0x98, 0x5B, 0x76, 0x01, 0x2C
+    },
+    {
+        0x00, 0x41, 0x82, 0xC3, 0x83, 0xC2, 0x01, 0x40,
+        0x81, 0xC0, 0x03, 0x42, 0x02, 0x43, 0x80, 0xC1,
+        0x00, 0x85, 0x8D, 0x08, 0x9D, 0x18, 0x10, 0x95,
+        0xBD, 0x38, 0x30, 0xB5, 0x20, 0xA5, 0xAD, 0x28
+    },
+    {
+        0x00, 0x73, 0xE6, 0x95, 0x4B, 0x38, 0xAD, 0xDE,
+        0x96, 0xE5, 0x70, 0x03, 0xDD, 0xAE, 0x3B, 0x48,
+        0x00, 0xAB, 0xD1, 0x7A, 0x25, 0x8E, 0xF4, 0x5F,
+        0x4A, 0xE1, 0x9B, 0x30, 0x6F, 0xC4, 0xBE, 0x15
+    },
+    {
+        0x00, 0x35, 0x6A, 0x5F, 0xD4, 0xE1, 0xBE, 0x8B,
+        0x2F, 0x1A, 0x45, 0x70, 0xFB, 0xCE, 0x91, 0xA4,
+        0x00, 0x5E, 0xBC, 0xE2, 0xFF, 0xA1, 0x43, 0x1D,
+        0x79, 0x27, 0xC5, 0x9B, 0x86, 0xD8, 0x3A, 0x64
+    },
+    {
+        0x00, 0x0B, 0x16, 0x1D, 0x2C, 0x27, 0x3A, 0x31,
+        0x58, 0x53, 0x4E, 0x45, 0x74, 0x7F, 0x62, 0x69,
+        0x00, 0xB0, 0xE7, 0x57, 0x49, 0xF9, 0xAE, 0x1E,
+        0x92, 0x22, 0x75, 0xC5, 0xDB, 0x6B, 0x3C, 0x8C
+    },
+    {
+        0x00, 0x0A, 0x14, 0x1E, 0x28, 0x22, 0x3C, 0x36,
+        0x50, 0x5A, 0x44, 0x4E, 0x78, 0x72, 0x6C, 0x66,
+        0x00, 0xA0, 0xC7, 0x67, 0x09, 0xA9, 0xCE, 0x6E,
+        0x12, 0xB2, 0xD5, 0x75, 0x1B, 0xBB, 0xDC, 0x7C
+    },
+    {
+        0x00, 0xA7, 0xC9, 0x6E, 0x15, 0xB2, 0xDC, 0x7B,
+        0x2A, 0x8D, 0xE3, 0x44, 0x3F, 0x98, 0xF6, 0x51,
+        0x00, 0x54, 0xA8, 0xFC, 0xD7, 0x83, 0x7F, 0x2B,
+        0x29, 0x7D, 0x81, 0xD5, 0xFE, 0xAA, 0x56, 0x02
+    },
+    {
+        0x00, 0x19, 0x32, 0x2B, 0x64, 0x7D, 0x56, 0x4F,
+        0xC8, 0xD1, 0xFA, 0xE3, 0xAC, 0xB5, 0x9E, 0x87,
+        0x00, 0x17, 0x2E, 0x39, 0x5C, 0x4B, 0x72, 0x65,
+        0xB8, 0xAF, 0x96, 0x81, 0xE4, 0xF3, 0xCA, 0xDD
+    },
+    {
+        0x00, 0x23, 0x46, 0x65, 0x8C, 0xAF, 0xCA, 0xE9,
+        0x9F, 0xBC, 0xD9, 0xFA, 0x13, 0x30, 0x55, 0x76,
+        0x00, 0xB9, 0xF5, 0x4C, 0x6D, 0xD4, 0x98, 0x21,
+        0xDA, 0x63, 0x2F, 0x96, 0xB7, 0x0E, 0x42, 0xFB
+    },
+    {
+        0x00, 0x1F, 0x3E, 0x21, 0x7C, 0x63, 0x42, 0x5D,
+        0xF8, 0xE7, 0xC6, 0xD9, 0x84, 0x9B, 0xBA, 0xA5,
+        0x00, 0x77, 0xEE, 0x99, 0x5B, 0x2C, 0xB5, 0xC2,
+        0xB6, 0xC1, 0x58, 0x2F, 0xED, 0x9A, 0x03, 0x74
+    },
+    {
+        0x00, 0xC3, 0x01, 0xC2, 0x02, 0xC1, 0x03, 0xC0,
+        0x04, 0xC7, 0x05, 0xC6, 0x06, 0xC5, 0x07, 0xC4,
+        0x00, 0x08, 0x10, 0x18, 0x20, 0x28, 0x30, 0x38,
+        0x40, 0x48, 0x50, 0x58, 0x60, 0x68, 0x70, 0x78
+    },
+    {
+        0x00, 0x95, 0xAD, 0x38, 0xDD, 0x48, 0x70, 0xE5,
+        0x3D, 0xA8, 0x90, 0x05, 0xE0, 0x75, 0x4D, 0xD8,
+        0x00, 0x7A, 0xF4, 0x8E, 0x6F, 0x15, 0x9B, 0xE1,
+        0xDE, 0xA4, 0x2A, 0x50, 0xB1, 0xCB, 0x45, 0x3F
+    },
+    {
+        0x00, 0x5F, 0xBE, 0xE1, 0xFB, 0xA4, 0x45, 0x1A,
+        0x71, 0x2E, 0xCF, 0x90, 0x8A, 0xD5, 0x34, 0x6B,
+        0x00, 0xE2, 0x43, 0xA1, 0x86, 0x64, 0xC5, 0x27,
+        0x8B, 0x69, 0xC8, 0x2A, 0x0D, 0xEF, 0x4E, 0xAC
+    },
+    {
+        0x00, 0x1D, 0x3A, 0x27, 0x74, 0x69, 0x4E, 0x53,
+        0xE8, 0xF5, 0xD2, 0xCF, 0x9C, 0x81, 0xA6, 0xBB,
+        0x00, 0x57, 0xAE, 0xF9, 0xDB, 0x8C, 0x75, 0x22,
+        0x31, 0x66, 0x9F, 0xC8, 0xEA, 0xBD, 0x44, 0x13
+    },
+    {
+        0x00, 0x1E, 0x3C, 0x22, 0x78, 0x66, 0x44, 0x5A,
+        0xF0, 0xEE, 0xCC, 0xD2, 0x88, 0x96, 0xB4, 0xAA,
+        0x00, 0x67, 0xCE, 0xA9, 0x1B, 0x7C, 0xD5, 0xB2,
+        0x36, 0x51, 0xF8, 0x9F, 0x2D, 0x4A, 0xE3, 0x84
+    }
+};
+
 const uint8_t ECC_BUF_LEN = 255;
+const uint8_t ECC_CODEWORDS_NUM = 4;
+
+/*************************************************************************************************/
+
+/** Reduce sum of logarithms modulo 255.
+ *
+ * \param x Sum of logarithms (less than 510).
+ *
+ * \return Reduced logarithm.
+ */
+static inline uint8_t ecc_log_reduce(
+        uint16_t x);
+
+/** Multiply field element by power of primitive element.
+ *
+ * \param x Field element (polynomial form).
+ * \param lg Power of primitive element (not greater than 255).
+ *
+ * \return Product (polynomial form).
+ */
+static inline uint8_t ecc_mul_alpha(
+        uint8_t x,
+        uint8_t lg);
+
+/** Calculate remainders of division by generator polynomial for all interleaved codewords.
+ *
+ * \param data Interleaved codewords.
+ * \param[out] rem Remainders (highest degree coefficient first) of each codeword.
+ */
+static void ecc_remainders(
+        const uint8_t *data,
+        uint8_t rem[][32]);
+
+/** Calculate syndromes of codeword from its remainder.
+ *
+ * \param rem Remainder of division by generator polynomial.
+ * \param[out] syndromes Syndromes (polynomial form).
+ *
+ * \return \c true if there are non-zero syndromes and \c false otherwise.
+ */
+static bool ecc_syndromes(
+        const uint8_t *rem,
+        uint8_t *syndromes);
+
+/** Correct single codeword.
+ *
+ * \param data Codeword to be corrected, interleaved with #ECC_CODEWORDS_NUM depth.
+ * \param syndromes Codeword syndromes (polynomial form).
+ *
+ * \return \c true on successfull decoding and \c false otherwise.
+ */
+static bool ecc_correct(
+        uint8_t *data,
+        const uint8_t *syndromes);
 
 /*************************************************************************************************/
 
-/* lrpt_decoder_ecc_interleave() */
-void lrpt_decoder_ecc_interleave(
-        const uint8_t *input,
-        uint8_t *output,
-        uint8_t pos,
-        uint8_t n) {
-    for (uint8_t i = 0; i < ECC_BUF_LEN; i++)
-        output[i * n + pos] = input[i];
+/* ecc_log_reduce() */
+static inline uint8_t ecc_log_reduce(
+        uint16_t x) {
+    return (x >= 255) ? (x - 255) : x;
 }
 
 /*************************************************************************************************/
 
-/* lrpt_decoder_ecc_deinterleave() */
-void lrpt_decoder_ecc_deinterleave(
-        const uint8_t *input,
-        uint8_t *output,
-        uint8_t pos,
-        uint8_t n) {
-    for (uint8_t i = 0; i < ECC_BUF_LEN; i++)
-        output[i] = input[i * n + pos];
+/* ecc_mul_alpha() */
+static inline uint8_t ecc_mul_alpha(
+        uint8_t x,
+        uint8_t lg) {
+    return (x == 0) ? 0 : ECC_ALPHA_TBL[ECC_IDX_TBL[x] + lg];
 }
 
 /*************************************************************************************************/
 
-/* lrpt_decoder_ecc_decode() */
-bool lrpt_decoder_ecc_decode(
-        uint8_t *data,
-        uint8_t pad) {
-    uint8_t s[32];
+/* ecc_remainders() */
+static void ecc_remainders(
+        const uint8_t *data,
+        uint8_t rem[][32]) {
+    /* Extra byte holds incoming data so register update is a plain shift */
+    uint8_t r[4][33];
+    memset(r, 0, sizeof(r));
+
+    for (uint8_t i = 0; i < ECC_BUF_LEN; i++) {
+        const uint8_t *p = (data + i * ECC_CODEWORDS_NUM);
+
+        for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++) {
+            const uint8_t t = r[n][0];
+            const uint8_t *lo = ECC_REM_TBL[t & 0x0F];
+            const uint8_t *hi = ECC_REM_TBL[16 + (t >> 4)];
+
+            r[n][32] = p[n];
+
+            for (uint8_t j = 0; j < 32; j++)
+                r[n][j] = (r[n][j + 1] ^ lo[j] ^ hi[j]);
+        }
+    }
+
+    for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++)
+        memcpy(rem[n], r[n], sizeof(uint8_t) * 32);
+}
+
+/*************************************************************************************************/
+
+/* ecc_syndromes() */
+static bool ecc_syndromes(
+        const uint8_t *rem,
+        uint8_t *syndromes) {
+    uint8_t rem_error = 0;
 
     for (uint8_t i = 0; i < 32; i++)
-        s[i] = data[0];
+        rem_error |= rem[i];
 
-    for (uint8_t i = 1; i < (ECC_BUF_LEN - pad); i++)
-        for (uint8_t j = 0; j < 32; j++)
-            if (s[j] == 0)
-                s[j] = data[i];
-            else
-                s[j] = data[i] ^ ECC_ALPHA_TBL[(ECC_IDX_TBL[s[j]] + (112 + j) * 11) % 255];
+    /* Codeword is a multiple of generator polynomial so all syndromes are zero */
+    if (rem_error == 0) {
+        memset(syndromes, 0, sizeof(uint8_t) * 32);
+
+        return false;
+    }
 
+    /* Generator polynomial vanishes at the roots so remainder gives the same syndromes */
+    for (uint8_t j = 0; j < 32; j++) {
+        uint8_t s = 0;
+
+        for (uint8_t i = 0; i < 32; i++)
+            s = rem[i] ^ ECC_SYN_MUL_TBL[j][s & 0x0F] ^ ECC_SYN_MUL_TBL[j][16 + (s >> 4)];
+
+        syndromes[j] = s;
+    }
+
+    return true;
+}
+
+/*************************************************************************************************/
+
+/* ecc_correct() */
+static bool ecc_correct(
+        uint8_t *data,
+        const uint8_t *syndromes) {
+    uint8_t s[32];
     uint8_t syn_error = 0;
 
     for (uint8_t i = 0; i < 32; i++) {
-        syn_error |= s[i];
-        s[i] = ECC_IDX_TBL[s[i]];
+        syn_error |= syndromes[i];
+        s[i] = ECC_IDX_TBL[syndromes[i]];
     }
 
     if (syn_error == 0)
@@ -180,7 +705,7 @@ bool lrpt_decoder_ecc_decode(
 
         for (uint8_t i = 0; i < r; i++)
             if ((lambda[i] != 0) && (s[r - i - 1] != 255))
-                discr_r ^= ECC_ALPHA_TBL[(ECC_IDX_TBL[lambda[i]] + s[r - i - 1]) % 255];
+                discr_r ^= ECC_ALPHA_TBL[ECC_IDX_TBL[lambda[i]] + s[r - i - 1]];
 
         discr_r = ECC_IDX_TBL[discr_r];
 
@@ -193,7 +718,7 @@ bool lrpt_decoder_ecc_decode(
 
             for (uint8_t i = 0; i < 32; i++) {
                 if (b[i] != 255)
-                    t[i + 1] = lambda[i + 1] ^ ECC_ALPHA_TBL[(discr_r + b[i]) % 255];
+                    t[i + 1] = lambda[i + 1] ^ ECC_ALPHA_TBL[discr_r + b[i]];
                 else
                     t[i + 1] = lambda[i + 1];
             }
@@ -205,7 +730,7 @@ bool lrpt_decoder_ecc_decode(
                     if (lambda[i] == 0)
                         b[i] = 255;
                     else
-                        b[i] = (ECC_IDX_TBL[lambda[i]] - discr_r + 255) % 255;
+                        b[i] = ecc_log_reduce(ECC_IDX_TBL[lambda[i]] + 255 - discr_r);
                 }
             }
             else { /* Append 255 to b array and shift it */
@@ -218,50 +743,61 @@ bool lrpt_decoder_ecc_decode(
     }
 
     uint8_t deg_lambda = 0;
+    uint8_t lambda_log[33];
 
     for (uint8_t i = 0; i < 33; i++) {
-        lambda[i] = ECC_IDX_TBL[lambda[i]];
+        lambda_log[i] = ECC_IDX_TBL[lambda[i]];
 
-        if (lambda[i] != 255)
+        if (lambda_log[i] != 255)
             deg_lambda = i;
     }
 
-    uint8_t reg[33];
-    memcpy((reg + 1), (lambda + 1), sizeof(uint8_t) * 32);
+    /* Chien search. Only non-zero terms of error locator are evaluated */
+    uint8_t reg[32], pwr[32];
+    uint8_t terms = 0;
 
-    uint8_t root[32], loc[32];
+    for (uint8_t i = 1; i <= deg_lambda; i++) {
+        if (lambda_log[i] != 255) {
+            reg[terms] = lambda_log[i];
+            pwr[terms] = i;
+            terms++;
+        }
+    }
+
+    uint8_t root[32], loc[32], root_pwr[32];
     uint8_t num_fixed = 0;
-    uint16_t k = 115;
+    uint8_t k = 115;
+    uint8_t k_pwr = 0;
 
-    for (uint8_t n = 0; n < 255; n++) {
+    for (uint16_t n = 0; n < 255; n++) {
         uint8_t q = 1;
 
-        for (uint8_t i = deg_lambda; i >= 1; i--) {
-            if (reg[i] != 255) {
-                reg[i] = (reg[i] + i) % 255;
-                q ^= ECC_ALPHA_TBL[reg[i]];
-            }
+        for (uint8_t i = 0; i < terms; i++) {
+            reg[i] = ecc_log_reduce(reg[i] + pwr[i]);
+            q ^= ECC_ALPHA_TBL[reg[i]];
         }
 
-        if (q != 0) {
-            k = (k + 116) % 255;
+        k_pwr = ecc_log_reduce(k_pwr + 111);
 
-            continue;
-        }
-
-        root[num_fixed] = (n + 1);
-        loc[num_fixed] = k;
-        num_fixed++;
+        if (q == 0) {
+            root[num_fixed] = (n + 1);
+            loc[num_fixed] = k;
+            root_pwr[num_fixed] = k_pwr;
+            num_fixed++;
 
-        if (num_fixed == deg_lambda)
-            break;
+            if (num_fixed == deg_lambda)
+                break;
+        }
+        else if ((deg_lambda - num_fixed) > (254 - n)) /* Not enough positions left */
+            return false;
 
-        k = (k + 116) % 255;
+        k = ecc_log_reduce(k + 116);
     }
 
     if (deg_lambda != num_fixed)
         return false;
 
+    /* Forney algorithm */
     uint8_t omega[33];
     uint8_t deg_omega = (deg_lambda - 1);
 
@@ -269,23 +805,22 @@ bool lrpt_decoder_ecc_decode(
         uint8_t tmp = 0;
 
         for (int8_t j = i; j >= 0; j--) { /* Signed type is needed for valid (j >= 0) */
-            if ((s[i - j] != 255) && (lambda[j] != 255))
-                tmp ^= ECC_ALPHA_TBL[(s[i - j] + lambda[j]) % 255];
+            if ((s[i - j] != 255) && (lambda_log[j] != 255))
+                tmp ^= ECC_ALPHA_TBL[s[i - j] + lambda_log[j]];
         }
 
-        omega[i] = ECC_IDX_TBL[tmp];
+        omega[i] = tmp;
     }
 
     for (uint8_t i = (num_fixed - 1); i >= 0; i--) {
+        /* Both polynomials are evaluated with Horner's scheme */
         uint8_t num1 = 0;
 
-        for (int8_t j = deg_omega; j >= 0; j--) { /* Signed type is needed for valid (j >= 0) */
-            if (omega[j] != 255)
-                num1 ^= ECC_ALPHA_TBL[(omega[j] + j * root[i]) % 255];
-        }
+        for (int8_t j = deg_omega; j >= 0; j--) /* Signed type is needed for valid (j >= 0) */
+            num1 = (ecc_mul_alpha(num1, root[i]) ^ omega[j]);
 
-        uint8_t num2 = ECC_ALPHA_TBL[(root[i] * 111 + 255) % 255];
         uint8_t den = 0;
+        uint8_t root2 = ecc_log_reduce(2 * root[i]);
 
         uint8_t l;
 
@@ -297,17 +832,16 @@ bool lrpt_decoder_ecc_decode(
         l &= ~1;
 
         for (; l >= 0; l -= 2) {
-            if (lambda[l + 1] != 255)
-                den ^= ECC_ALPHA_TBL[(lambda[l + 1] + l * root[i]) % 255];
+            den = (ecc_mul_alpha(den, root2) ^ lambda[l + 1]);
 
             if (l == 0)
                 break;
         }
 
-        if ((num1 != 0) && (loc[i] >= pad))
-            data[loc[i] - pad] ^=
-                ECC_ALPHA_TBL[(ECC_IDX_TBL[num1] + ECC_IDX_TBL[num2] +
-                        255 - ECC_IDX_TBL[den]) % 255];
+        if (num1 != 0)
+            data[loc[i] * ECC_CODEWORDS_NUM] ^=
+                ECC_ALPHA_TBL[ecc_log_reduce(ECC_IDX_TBL[num1] + root_pwr[i]) +
+                255 - ECC_IDX_TBL[den]];
 
         if (i == 0)
             break;
@@ -318,4 +852,30 @@ bool lrpt_decoder_ecc_decode(
 
 /*************************************************************************************************/
 
+/* lrpt_decoder_ecc_decode() */
+bool lrpt_decoder_ecc_decode(
+        uint8_t *data,
+        bool *results) {
+    uint8_t rem[4][32];
+    bool ok = true;
+
+    ecc_remainders(data, rem);
+
+    for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++) {
+        uint8_t s[32];
+
+        /* Clean codewords are the most common case, there is nothing to correct for them */
+        if (ecc_syndromes(rem[n], s))
+            results[n] = ecc_correct((data + n), s);
+        else
+            results[n] = true;
+
+        ok = (ok && results[n]);
+    }
+
+    return ok;
+}
+
+/*************************************************************************************************/
+
 /** \endcond */
@@ -39,46 +39,24 @@
 
 /*************************************************************************************************/
 
-extern const uint8_t ECC_BUF_LEN; /**< ECC buffer length */
+extern const uint8_t ECC_BUF_LEN; /**< ECC codeword length */
+extern const uint8_t ECC_CODEWORDS_NUM; /**< Number of interleaved codewords */
 
 /*************************************************************************************************/
 
-/** Perform ECC interleaving.
+/** Perform ECC decoding of interleaved codewords.
  *
- * \param input Input data.
- * \param output Resulting data.
- * \param pos Starting position.
- * \param n The length of data to be interleaved.
- */
-void lrpt_decoder_ecc_interleave(
-        const uint8_t *input,
-        uint8_t *output,
-        uint8_t pos,
-        uint8_t n);
-
-/** Perform ECC deinterleaving.
- *
- * \param input Input data.
- * \param output Resulting data.
- * \param pos Starting position.
- * \param n The length of data to be deinterleaved.
- */
-void lrpt_decoder_ecc_deinterleave(
-        const uint8_t *input,
-        uint8_t *output,
-        uint8_t pos,
-        uint8_t n);
-
-/** Perform ECC decoding.
+ * Syndromes of all codewords are calculated in a single pass over interleaved data, so no
+ * deinterleaving is needed. Codewords are corrected in place.
  *
- * \param data Data to be decoded.
- * \param pad Padding.
+ * \param data Interleaved codewords (#ECC_CODEWORDS_NUM of #ECC_BUF_LEN bytes each).
+ * \param[out] results Decoding result for each codeword.
  *
- * \return \c true on successfull decoding and \c false otherwise.
+ * \return \c true if all codewords were decoded successfully and \c false otherwise.
  */
 bool lrpt_decoder_ecc_decode(
         uint8_t *data,
-        uint8_t pad);
+        bool *results);
 
 /*************************************************************************************************/
 
@@ -34,292 +34,291 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
-#include <string.h>
 
 /*************************************************************************************************/
 
-/* List of AC numbers of Y component */
-static const uint8_t HUFF_AC_Y_TBL[178] = {
-    0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 125,
-    1  , 2  , 3  , 0  , 4  , 17 , 5  , 18 , 33 ,
-    49 , 65 , 6  , 19 , 81 , 97 , 7  , 34 , 113,
-    20 , 50 , 129, 145, 161, 8  , 35 , 66 , 177,
-    193, 21 , 82 , 209, 240, 36 , 51 , 98 , 114,
-    130, 9  , 10 , 22 , 23 , 24 , 25 , 26 , 37 ,
-    38 , 39 , 40 , 41 , 42 , 52 , 53 , 54 , 55 ,
-    56 , 57 , 58 , 67 , 68 , 69 , 70 , 71 , 72 ,
-    73 , 74 , 83 , 84 , 85 , 86 , 87 , 88 , 89 ,
-    90 , 99 , 100, 101, 102, 103, 104, 105, 106,
-    115, 116, 117, 118, 119, 120, 121, 122, 131,
-    132, 133, 134, 135, 136, 137, 138, 146, 147,
-    148, 149, 150, 151, 152, 153, 154, 162, 163,
-    164, 165, 166, 167, 168, 169, 170, 178, 179,
-    180, 181, 182, 183, 184, 185, 186, 194, 195,
-    196, 197, 198, 199, 200, 201, 202, 210, 211,
-    212, 213, 214, 215, 216, 217, 218, 225, 226,
-    227, 228, 229, 230, 231, 232, 233, 234, 241,
-    242, 243, 244, 245, 246, 247, 248, 249, 250
-};
-
-static const size_t HUFF_ACDC_TBL_LEN = 65536; /**< AC and DC tables length */
+/** Maximum length of Huffman code */
+static const uint8_t HUFF_MAX_CODE_LEN = 16;
 
-/*****************************************************************************/
+static const uint8_t HUFF_DC_LUT_BITS = 9; /**< Number of bits indexing DC lookup table */
 
-/** Return AC Huffman code.
- *
- * \param huff Pointer to the Huffman decoder object.
- * \param w Index.
- *
- * \return AC Huffman code or \c -1 in case of error.
+/** @{ */
+/** Canonical code ranges and #HUFF_AC_TBL offsets for each AC code length (ITU-T T.81, table
+ * K.5), empty lengths have the range inverted
  */
-static int32_t get_ac_real(
-        const lrpt_decoder_huffman_t *huff,
-        uint16_t w);
-
-/** Return DC Huffman code.
- *
- * \param w Index.
- *
- * \return DC Huffman code or \c -1 in case of error.
- */
-static int32_t get_dc_real(
-        uint16_t w);
-
-/*****************************************************************************/
-
-/* get_ac_real() */
-static int32_t get_ac_real(
-        const lrpt_decoder_huffman_t *huff,
-        uint16_t w) {
-    for (size_t i = 0; i < huff->ac_tbl_len; i++)
-        if (((w >> (16 - huff->ac_tbl[i].len)) & huff->ac_tbl[i].mask) == huff->ac_tbl[i].code)
-            return i;
-
-    return -1;
-}
-
-/*****************************************************************************/
-
-/* get_dc_real() */
-static int32_t get_dc_real(
-        uint16_t w) {
-    /* Standard Codecs: Image Compression to Advanced Video Coding (IET Telecommunications Series),
-     * M. Ghanbari. Appendix B, table B.1
-     */
-    if ((w >> 14) == 0)
-        return 0;
-
-    switch (w >> 13) {
-        case 2:
-            return 1;
-
-            break;
-
-        case 3:
-            return 2;
-
-            break;
-
-        case 4:
-            return 3;
-
-            break;
-
-        case 5:
-            return 4;
-
-            break;
+static const uint16_t HUFF_AC_MIN_CODE[17] = {
+    0xFFFF, 0xFFFF, 0x0000, 0x0004, 0x000A, 0x001A, 0x003A, 0x0078,
+    0x00F8, 0x01F6, 0x03F6, 0x07F6, 0x0FF4, 0xFFFF, 0xFFFF, 0x7FC0,
+    0xFF82
+};
 
-        case 6:
-            return 5;
+static const uint16_t HUFF_AC_MAX_CODE[17] = {
+    0x0000, 0x0000, 0x0001, 0x0004, 0x000C, 0x001C, 0x003B, 0x007B,
+    0x00FA, 0x01FA, 0x03FA, 0x07F9, 0x0FF7, 0x0000, 0x0000, 0x7FC0,
+    0xFFFE
+};
 
-            break;
-    }
+static const uint8_t HUFF_AC_FIRST[17] = {
+    0, 0, 0, 2, 3, 6, 9, 11, 15, 18, 23, 28, 32, 36, 36, 36, 37
+};
+/** @} */
+
+/** AC table entries in canonical code order (ITU-T T.81, table K.5) */
+static const uint16_t HUFF_AC_TBL[162] = {
+    0x0201, 0x0202, 0x0303, 0x0400, 0x0404, 0x0411, 0x0505, 0x0512,
+    0x0521, 0x0631, 0x0641, 0x0706, 0x0713, 0x0751, 0x0761, 0x0807,
+    0x0822, 0x0871, 0x0914, 0x0932, 0x0981, 0x0991, 0x09A1, 0x0A08,
+    0x0A23, 0x0A42, 0x0AB1, 0x0AC1, 0x0B15, 0x0B52, 0x0BD1, 0x0BF0,
+    0x0C24, 0x0C33, 0x0C62, 0x0C72, 0x0F82, 0x1009, 0x100A, 0x1016,
+    0x1017, 0x1018, 0x1019, 0x101A, 0x1025, 0x1026, 0x1027, 0x1028,
+    0x1029, 0x102A, 0x1034, 0x1035, 0x1036, 0x1037, 0x1038, 0x1039,
+    0x103A, 0x1043, 0x1044, 0x1045, 0x1046, 0x1047, 0x1048, 0x1049,
+    0x104A, 0x1053, 0x1054, 0x1055, 0x1056, 0x1057, 0x1058, 0x1059,
+    0x105A, 0x1063, 0x1064, 0x1065, 0x1066, 0x1067, 0x1068, 0x1069,
+    0x106A, 0x1073, 0x1074, 0x1075, 0x1076, 0x1077, 0x1078, 0x1079,
+    0x107A, 0x1083, 0x1084, 0x1085, 0x1086, 0x1087, 0x1088, 0x1089,
+    0x108A, 0x1092, 0x1093, 0x1094, 0x1095, 0x1096, 0x1097, 0x1098,
+    0x1099, 0x109A, 0x10A2, 0x10A3, 0x10A4, 0x10A5, 0x10A6, 0x10A7,
+    0x10A8, 0x10A9, 0x10AA, 0x10B2, 0x10B3, 0x10B4, 0x10B5, 0x10B6,
+    0x10B7, 0x10B8, 0x10B9, 0x10BA, 0x10C2, 0x10C3, 0x10C4, 0x10C5,
+    0x10C6, 0x10C7, 0x10C8, 0x10C9, 0x10CA, 0x10D2, 0x10D3, 0x10D4,
+    0x10D5, 0x10D6, 0x10D7, 0x10D8, 0x10D9, 0x10DA, 0x10E1, 0x10E2,
+    0x10E3, 0x10E4, 0x10E5, 0x10E6, 0x10E7, 0x10E8, 0x10E9, 0x10EA,
+    0x10F1, 0x10F2, 0x10F3, 0x10F4, 0x10F5, 0x10F6, 0x10F7, 0x10F8,
+    0x10F9, 0x10FA
+};
 
-    if ((w >> 12) == 0x0E)
-        return 6;
-    else if ((w >> 11) == 0x1E)
-        return 7;
-    else if ((w >> 10) == 0x3E)
-        return 8;
-    else if ((w >> 9) == 0x7E)
-        return 9;
-    else if ((w >> 8) == 0xFE)
-        return 10;
-    else if ((w >> 7) == 0x01FE)
-        return 11;
-    else
-        return -1;
-}
+/** DC lookup table, indexed by next #HUFF_DC_LUT_BITS bits of the stream (ITU-T T.81,
+ * table K.3)
+ */
+static const uint16_t HUFF_DC_LUT[512] = {
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302,
+    0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302,
+    0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302,
+    0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302,
+    0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302,
+    0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302,
+    0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302,
+    0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302, 0x0302,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304,
+    0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304,
+    0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304,
+    0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304,
+    0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304,
+    0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304,
+    0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304,
+    0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304, 0x0304,
+    0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305,
+    0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305,
+    0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305,
+    0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305,
+    0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305,
+    0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305,
+    0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305,
+    0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305, 0x0305,
+    0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406,
+    0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406,
+    0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406,
+    0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406, 0x0406,
+    0x0507, 0x0507, 0x0507, 0x0507, 0x0507, 0x0507, 0x0507, 0x0507,
+    0x0507, 0x0507, 0x0507, 0x0507, 0x0507, 0x0507, 0x0507, 0x0507,
+    0x0608, 0x0608, 0x0608, 0x0608, 0x0608, 0x0608, 0x0608, 0x0608,
+    0x0709, 0x0709, 0x0709, 0x0709, 0x080A, 0x080A, 0x090B, 0x0000
+};
 
 /*************************************************************************************************/
 
-/* lrpt_decoder_huffman_init() */
-lrpt_decoder_huffman_t *lrpt_decoder_huffman_init(void) {
-    /* Allocate Huffman decoder object */
-    lrpt_decoder_huffman_t *huff = malloc(sizeof(lrpt_decoder_huffman_t));
-
-    if (!huff)
-        return NULL;
-
-    /* NULL-init internal tables for safe deallocation */
-    huff->ac_tbl = NULL;
-    huff->ac_lut = NULL;
-    huff->dc_lut = NULL;
-
-    /* Allocate helper vector */
-    uint8_t *v = calloc(65536, sizeof(uint8_t));
-
-    if (!v) {
-        lrpt_decoder_huffman_deinit(huff);
-
-        return NULL;
-    }
-
-    /* Populate helper vector */
-    uint8_t p = 16;
-
-    for (uint8_t i = 1; i <= 16; i++)
-        for (uint8_t j = 0; j < HUFF_AC_Y_TBL[i - 1]; j++) {
-            v[(i << 8) + j] = HUFF_AC_Y_TBL[p];
-            p++;
-        }
-
-    /* Populate codes */
-    uint16_t min_code[17], maj_code[17];
-    uint32_t code = 0;
-
-    for (uint8_t i = 1; i <= 16; i++) {
-        min_code[i] = code;
-
-        if (HUFF_AC_Y_TBL[i - 1] >= 1)
-            code += HUFF_AC_Y_TBL[i - 1];
-
-        maj_code[i] = (code - ((code != 0) ? 1 : 0));
-        code *= 2;
-
-        if (HUFF_AC_Y_TBL[i - 1] == 0) {
-            min_code[i] = 0xFFFF;
-            maj_code[i] = 0;
-        }
-    }
-
-    /* Allocate AC table */
-    huff->ac_tbl_len = 256;
-    huff->ac_tbl = calloc(huff->ac_tbl_len, sizeof(lrpt_decoder_huffman_acdata_t));
-
-    /* Allocate lookup tables */
-    huff->ac_lut = calloc(HUFF_ACDC_TBL_LEN, sizeof(int32_t));
-    huff->dc_lut = calloc(HUFF_ACDC_TBL_LEN, sizeof(int32_t));
-
-    if (!huff->ac_tbl || !huff->ac_lut || !huff->dc_lut) {
-        free(v);
-        lrpt_decoder_huffman_deinit(huff);
-
-        return NULL;
-    }
-
-    size_t n = 0;
-    uint8_t min_valn = 1;
-    uint8_t max_valn = 1;
-
-    for (uint8_t i = 1; i <= 16; i++) {
-        uint16_t min_val = min_code[min_valn];
-        uint16_t max_val = maj_code[max_valn];
-
-        for (uint32_t j = 0; j < (1 << i); j++) {
-            if ((j <= max_val) && (j >= min_val)) {
-                uint16_t size_val = v[(i << 8) + j - min_val];
-
-                huff->ac_tbl[n].run = (size_val >> 4);
-                huff->ac_tbl[n].size = (size_val & 0x0F);
-                huff->ac_tbl[n].len = i;
-                huff->ac_tbl[n].mask = ((1 << i) - 1);
-                huff->ac_tbl[n].code = j;
-
-                n++;
-            }
-        }
-
-        min_valn++;
-        max_valn++;
-    }
-
-    /* Reallocate AC table */
-    lrpt_decoder_huffman_acdata_t *new_ac_tbl =
-        reallocarray(huff->ac_tbl, n, sizeof(lrpt_decoder_huffman_acdata_t));
+const uint8_t HUFF_AC_LUT_BITS = 10;
+
+const uint16_t HUFF_AC_LUT[1024] = {
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202, 0x0202,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303, 0x0303,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404,
+    0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404,
+    0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404,
+    0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404,
+    0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404,
+    0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404,
+    0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404,
+    0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404, 0x0404,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505,
+    0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505,
+    0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505,
+    0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505, 0x0505,
+    0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512,
+    0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512,
+    0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512,
+    0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512,
+    0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521,
+    0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521,
+    0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521,
+    0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521,
+    0x0631, 0x0631, 0x0631, 0x0631, 0x0631, 0x0631, 0x0631, 0x0631,
+    0x0631, 0x0631, 0x0631, 0x0631, 0x0631, 0x0631, 0x0631, 0x0631,
+    0x0641, 0x0641, 0x0641, 0x0641, 0x0641, 0x0641, 0x0641, 0x0641,
+    0x0641, 0x0641, 0x0641, 0x0641, 0x0641, 0x0641, 0x0641, 0x0641,
+    0x0706, 0x0706, 0x0706, 0x0706, 0x0706, 0x0706, 0x0706, 0x0706,
+    0x0713, 0x0713, 0x0713, 0x0713, 0x0713, 0x0713, 0x0713, 0x0713,
+    0x0751, 0x0751, 0x0751, 0x0751, 0x0751, 0x0751, 0x0751, 0x0751,
+    0x0761, 0x0761, 0x0761, 0x0761, 0x0761, 0x0761, 0x0761, 0x0761,
+    0x0807, 0x0807, 0x0807, 0x0807, 0x0822, 0x0822, 0x0822, 0x0822,
+    0x0871, 0x0871, 0x0871, 0x0871, 0x0914, 0x0914, 0x0932, 0x0932,
+    0x0981, 0x0981, 0x0991, 0x0991, 0x09A1, 0x09A1, 0x0A08, 0x0A23,
+    0x0A42, 0x0AB1, 0x0AC1, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+};
 
-    if (!new_ac_tbl) {
-        free(v);
-        lrpt_decoder_huffman_deinit(huff);
+/*************************************************************************************************/
 
-        return NULL;
-    }
+/* lrpt_decoder_huffman_get_ac() */
+uint16_t lrpt_decoder_huffman_get_ac(
+        uint16_t w) {
+    const uint16_t entry = HUFF_AC_LUT[w >> (HUFF_MAX_CODE_LEN - HUFF_AC_LUT_BITS)];
 
-    /* Zero out newly allocated portion (if any) */
-    if (n > huff->ac_tbl_len)
-        memset(new_ac_tbl + huff->ac_tbl_len, 0,
-                sizeof(lrpt_decoder_huffman_acdata_t) * (n - huff->ac_tbl_len));
+    if (entry != 0)
+        return entry;
 
-    huff->ac_tbl = new_ac_tbl;
-    huff->ac_tbl_len = n;
+    for (uint8_t len = (HUFF_AC_LUT_BITS + 1); len <= HUFF_MAX_CODE_LEN; len++) {
+        const uint16_t code = (w >> (HUFF_MAX_CODE_LEN - len));
 
-    /* Fill up AC and DC tables */
-    for (size_t i = 0; i < HUFF_ACDC_TBL_LEN; i++) {
-        huff->ac_lut[i] = get_ac_real(huff, i);
-        huff->dc_lut[i] = get_dc_real(i);
+        if ((code >= HUFF_AC_MIN_CODE[len]) && (code <= HUFF_AC_MAX_CODE[len]))
+            return HUFF_AC_TBL[HUFF_AC_FIRST[len] + code - HUFF_AC_MIN_CODE[len]];
     }
 
-    /* Free helper vector */
-    free(v);
-
-    return huff;
-}
-
-/*************************************************************************************************/
-
-/* lrpt_decoder_huffman_deinit() */
-void lrpt_decoder_huffman_deinit(lrpt_decoder_huffman_t *huff) {
-    if (!huff)
-        return;
-
-    free(huff->dc_lut);
-    free(huff->ac_lut);
-    free(huff->ac_tbl);
-    free(huff);
-}
-
-/*************************************************************************************************/
-
-/* lrpt_decoder_huffman_get_ac() */
-int32_t lrpt_decoder_huffman_get_ac(
-        const lrpt_decoder_huffman_t *huff,
-        uint16_t w) {
-    return huff->ac_lut[w];
+    return 0;
 }
 
 /*************************************************************************************************/
 
 /* lrpt_decoder_huffman_get_dc() */
-int32_t lrpt_decoder_huffman_get_dc(
-        const lrpt_decoder_huffman_t *huff,
+uint16_t lrpt_decoder_huffman_get_dc(
         uint16_t w) {
-    return huff->dc_lut[w];
-}
-
-/*************************************************************************************************/
-
-/* lrpt_decoder_huffman_map_range() */
-int32_t lrpt_decoder_huffman_map_range(
-        uint8_t cat,
-        uint16_t val) {
-    uint16_t maxval = ((1 << cat) - 1);
-
-    if ((val >> (cat - 1)) != 0)
-        return val;
-    else
-        return (val - maxval);
+    return HUFF_DC_LUT[w >> (HUFF_MAX_CODE_LEN - HUFF_DC_LUT_BITS)];
 }
 
 /*************************************************************************************************/
@@ -38,71 +38,37 @@
 
 /*************************************************************************************************/
 
-/** Decoder AC table data */
-typedef struct lrpt_decoder_huffman_acdata__ {
-    uint16_t run;
-    uint8_t size;
-    uint8_t len;
-    uint16_t mask;
-    uint32_t code;
-} lrpt_decoder_huffman_acdata_t;
-
-/** Huffman decoder object */
-typedef struct lrpt_decoder_huffman__ {
-    size_t ac_tbl_len; /**< AC table length */
-    lrpt_decoder_huffman_acdata_t *ac_tbl; /**< AC table */
-
-    int32_t *ac_lut; /**< AC lookup table */
-    int32_t *dc_lut; /**< DC lookup table */
-} lrpt_decoder_huffman_t;
+extern const uint8_t HUFF_AC_LUT_BITS; /**< Number of bits indexing AC first-level lookup table */
 
-/*************************************************************************************************/
-
-/** Allocate and initialize Huffman decoder object.
+/** AC first-level lookup table, indexed by next #HUFF_AC_LUT_BITS bits of the stream.
  *
- * \return Pointer to the allocated Huffman decoder object or \c NULL in case of error.
+ * Lookup entries are packed as <tt>(code length << 8) | (run << 4) | size</tt>. Zero entry means
+ * the code is longer than #HUFF_AC_LUT_BITS bits.
  */
-lrpt_decoder_huffman_t *lrpt_decoder_huffman_init(void);
+extern const uint16_t HUFF_AC_LUT[];
 
-/** Free previously allocated Huffman decoder.
- *
- * \param huff Pointer to the Huffman decoder object.
- */
-void lrpt_decoder_huffman_deinit(lrpt_decoder_huffman_t *huff);
+/*************************************************************************************************/
 
 /** Get AC Huffman code.
  *
- * \param huff Pointer to the Huffman decoder object.
- * \param w Index.
+ * First-level lookup table is tried first, longer codes are decoded by canonical code ranges.
  *
- * \return AC Huffman code.
+ * \param w Next 16 bits of the stream, MSB first.
+ *
+ * \return Packed lookup entry (see #HUFF_AC_LUT) or \c 0 in case of error.
  */
-int32_t lrpt_decoder_huffman_get_ac(
-        const lrpt_decoder_huffman_t *huff,
+uint16_t lrpt_decoder_huffman_get_ac(
         uint16_t w);
 
 /** Get DC Huffman code.
  *
- * \param huff Pointer to the Huffman decoder object.
- * \param w Index.
+ * \param w Next 16 bits of the stream, MSB first.
  *
- * \return DC Huffman code.
+ * \return Packed lookup entry (see #HUFF_AC_LUT, run is always zero) or \c 0 in case of error.
  */
-int32_t lrpt_decoder_huffman_get_dc(
-        const lrpt_decoder_huffman_t *huff,
+uint16_t lrpt_decoder_huffman_get_dc(
         uint16_t w);
 
-/** Perform mapping.
- *
- * \param cat Category.
- * \param val Value.
- *
- * \return Mapped range value.
- */
-int32_t lrpt_decoder_huffman_map_range(
-        uint8_t cat,
-        uint16_t val);
-
 /*************************************************************************************************/
 
 #endif
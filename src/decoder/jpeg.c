@@ -33,6 +33,7 @@
 #include "jpeg.h"
 
 #include "../../include/lrpt.h"
+#include "../liblrpt/image.h"
 #include "bitop.h"
 #include "decoder.h"
 #include "huffman.h"
@@ -46,6 +47,12 @@
 
 /*************************************************************************************************/
 
+/** Number of MCUs in each image packet */
+static const uint8_t JPEG_PCK_MCUS = 14;
+
+/** Maximum quality factor with distinct quantization table */
+static const uint8_t JPEG_DQT_Q_MAX = 100;
+
 /** Standard quantization table */
 static const uint8_t JPEG_STD_QUANT_TBL[64] = {
     16,  11,  10,  16,  24,  40,  51,  61,
@@ -58,43 +65,154 @@ static const uint8_t JPEG_STD_QUANT_TBL[64] = {
     72,  92,  95,  98, 112, 100, 103,  99
 };
 
-/** Zigzag table */
-static const uint8_t JPEG_ZZ_TBL[64] = {
-    0 , 1 , 5 , 6 , 14, 15, 27, 28,
-    2 , 4 , 7 , 13, 16, 26, 29, 42,
-    3 , 8 , 12, 17, 25, 30, 41, 43,
-    9 , 11, 18, 24, 31, 40, 44, 53,
-    10, 19, 23, 32, 39, 45, 52, 54,
-    20, 22, 33, 38, 46, 51, 55, 60,
-    21, 34, 37, 47, 50, 56, 59, 61,
-    35, 36, 48, 49, 57, 58, 62, 63
+/** Natural (row-major) positions of coefficients in zigzag order */
+static const uint8_t JPEG_NATURAL_TBL[64] = {
+    0 , 1 , 8 , 16, 9 , 2 , 3 , 10,
+    17, 24, 32, 25, 18, 11, 4 , 5 ,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13, 6 , 7 , 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63
 };
 
-/** Offsets for DC Huffman codes */
-static const uint8_t JPEG_DC_CAT_OFFSET[12] = { 2, 3, 3, 3, 3, 3, 4, 5, 6, 7, 8, 9 };
+#ifndef LIBLRPT_JPEG_FLOAT_IDCT
+/** @{ */
+/** Fixed-point IDCT precision: fractional bits of constants and extra bits kept after first pass */
+static const uint8_t JPEG_IDCT_CONST_BITS = 13;
+static const uint8_t JPEG_IDCT_PASS1_BITS = 2;
+/** @} */
+
+/** Dequantized DCT coefficients are clamped to this range so fixed-point IDCT can't overflow.
+ * Coefficients of valid 8-bit data fit into it anyway
+ */
+static const int32_t JPEG_IDCT_COEFF_MAX = 1023;
+
+/** Last zigzag index which is still inside the top-left 4x4 corner of the block */
+static const uint8_t JPEG_IDCT_SPARSE_LAST = 9;
+
+/** @{ */
+/** IDCT constants, scaled by 2^JPEG_IDCT_CONST_BITS */
+static const int32_t JPEG_FIX_0_298631336 = 2446;
+static const int32_t JPEG_FIX_0_390180644 = 3196;
+static const int32_t JPEG_FIX_0_541196100 = 4433;
+static const int32_t JPEG_FIX_0_765366865 = 6270;
+static const int32_t JPEG_FIX_0_899976223 = 7373;
+static const int32_t JPEG_FIX_1_175875602 = 9633;
+static const int32_t JPEG_FIX_1_501321110 = 12299;
+static const int32_t JPEG_FIX_1_847759065 = 15137;
+static const int32_t JPEG_FIX_1_961570560 = 16069;
+static const int32_t JPEG_FIX_2_053119869 = 16819;
+static const int32_t JPEG_FIX_2_562915447 = 20995;
+static const int32_t JPEG_FIX_3_072711026 = 25172;
+/** @} */
+#endif
 
 /*************************************************************************************************/
 
-/** Perform fast lapped discrete cosine transform for 8x8 block.
+/** Map additional bits of Huffman code to the coefficient value.
+ *
+ * \param cat Category (number of additional bits).
+ * \param val Additional bits.
+ *
+ * \return Coefficient value.
+ */
+static inline int32_t map_range(
+        uint8_t cat,
+        uint32_t val);
+
+#ifdef LIBLRPT_JPEG_FLOAT_IDCT
+/** Perform reference floating-point inverse discrete cosine transform for 8x8 block.
  *
  * \param jpeg Pointer to the JPEG decoder object.
- * \param res Resulting array.
+ * \param res Resulting pixels.
  * \param in Input DCT.
  */
 static void flt_idct_8x8(
         lrpt_decoder_jpeg_t *jpeg,
-        double *res,
+        uint8_t *res,
         const int32_t *in);
+#else
+/** Perform one pass of fixed-point inverse discrete cosine transform.
+ *
+ * Every column of input is transformed independently and result is stored transposed, so the
+ * second pass is exactly the same as the first one.
+ *
+ * \param in Input data.
+ * \param[out] out Transformed and transposed data.
+ * \param shift Number of bits to descale result by.
+ */
+static inline void int_idct_pass(
+        const int32_t *in,
+        int32_t *out,
+        uint8_t shift);
+
+/** Perform one pass of fixed-point inverse discrete cosine transform for sparse data.
+ *
+ * The same as #int_idct_pass() but only first 4 rows of input can be non-zero, so the terms
+ * with the rest of rows are skipped.
+ *
+ * \param in Input data.
+ * \param[out] out Transformed and transposed data.
+ * \param shift Number of bits to descale result by.
+ * \param cols Number of columns to transform. The rest of output is zeroed.
+ */
+static inline void int_idct_pass_sparse(
+        const int32_t *in,
+        int32_t *out,
+        uint8_t shift,
+        uint8_t cols);
+
+/** Perform fixed-point inverse discrete cosine transform for 8x8 block.
+ *
+ * Separable Loeffler-Ligtenberg-Moschytz algorithm, the same as in IJG's \c jidctint.c.
+ * Blocks with DC coefficient only and blocks with non-zero coefficients in the top-left 4x4
+ * corner only are transformed with shortcuts which give exactly the same result.
+ *
+ * \param jpeg Pointer to the JPEG decoder object.
+ * \param res Resulting pixels.
+ * \param in Input DCT.
+ * \param last Last non-zero coefficient index (in zigzag order).
+ */
+static void int_idct_8x8(
+        lrpt_decoder_jpeg_t *jpeg,
+        uint8_t *res,
+        const int32_t *in,
+        uint8_t last);
+#endif
 
 /** Fill quantization table.
  *
- * \param dqt Pointer to the dqt table.
+ * \param dqt Pointer to the dqt table (in zigzag order).
  * \param q Quality factor value.
  */
 static void fill_dqt_by_q(
         uint16_t *dqt,
         uint8_t q);
 
+/** Get cached quantization table, table is filled on first use.
+ *
+ * \param jpeg Pointer to the JPEG decoder object.
+ * \param q Quality factor value.
+ *
+ * \return Pointer to the quantization table (in zigzag order).
+ */
+static const uint16_t *dqt_by_q(
+        lrpt_decoder_jpeg_t *jpeg,
+        uint8_t q);
+
+/** Dequantize DCT coefficient.
+ *
+ * \param c Coefficient.
+ * \param dqt Quantization table entry.
+ *
+ * \return Dequantized coefficient.
+ */
+static inline int32_t dequantize(
+        int32_t c,
+        uint16_t dqt);
+
 /** Advance image buffers.
  *
  * \param decoder Pointer to the decoder object.
@@ -110,27 +228,85 @@ static bool progress_image(
         uint8_t mcu_id,
         uint16_t pck_cnt);
 
+/** Decode MCUs of single packet.
+ *
+ * Packet is self-contained (DC prediction starts from zero in every packet), so decoding doesn't
+ * depend on the decoder state and image isn't touched.
+ *
+ * \param jpeg Pointer to the JPEG decoder object.
+ * \param p Entropy-coded data.
+ * \param len Data length.
+ * \param q Quality.
+ * \param[out] pix Pixels of MCUs, 64 per MCU (in natural order).
+ *
+ * \return Number of MCUs decoded before the end or the first error.
+ */
+static uint8_t decode_packet(
+        lrpt_decoder_jpeg_t *jpeg,
+        const uint8_t *p,
+        size_t len,
+        uint8_t q,
+        uint8_t *pix);
+
 /** Fill pixels.
  *
  * \param decoder Pointer to the decoder object.
- * \param img_dct Image DCT.
+ * \param pix Pixels of MCUs, 64 per MCU (in natural order).
  * \param apid APID number.
- * \param mcu_id ID of current MCU.
- * \param m MCU index.
+ * \param mcu_id ID of first MCU.
+ * \param n Number of MCUs.
  */
 static void fill_pix(
         lrpt_decoder_t *decoder,
-        double *img_dct,
+        const uint8_t *pix,
+        uint16_t apid,
+        uint8_t mcu_id,
+        uint8_t n);
+
+/** Report row of MCUs to the user callback.
+ *
+ * \param decoder Pointer to the decoder object.
+ * \param apid APID number.
+ * \param y First line of row.
+ */
+static void report_rows(
+        lrpt_decoder_t *decoder,
+        uint16_t apid,
+        size_t y);
+
+/** Track rows completion and report complete rows.
+ *
+ * \param decoder Pointer to the decoder object.
+ * \param apid APID number.
+ * \param mcu_id ID of first MCU.
+ * \param n Number of decoded MCUs.
+ */
+static void track_rows(
+        lrpt_decoder_t *decoder,
         uint16_t apid,
         uint8_t mcu_id,
-        uint8_t m);
+        uint8_t n);
 
 /*************************************************************************************************/
 
+/* map_range() */
+static inline int32_t map_range(
+        uint8_t cat,
+        uint32_t val) {
+    /* Values with MSB cleared are negative */
+    if ((cat == 0) || ((val >> (cat - 1)) != 0))
+        return val;
+    else
+        return ((int32_t)val - ((1 << cat) - 1));
+}
+
+/*************************************************************************************************/
+
+#ifdef LIBLRPT_JPEG_FLOAT_IDCT
 /* flt_idct_8x8() */
 static void flt_idct_8x8(
         lrpt_decoder_jpeg_t *jpeg,
-        double *res,
+        uint8_t *res,
         const int32_t *in) {
     for (uint8_t y = 0; y < 8; y++) {
         for (uint8_t x = 0; x < 8; x++) {
@@ -147,10 +323,188 @@ static void flt_idct_8x8(
                 s += ss;
             }
 
-            res[y * 8 + x] = s / 4.0;
+            int32_t t = round(s / 4.0 + 128.0);
+
+            if (t < 0)
+                t = 0;
+
+            if (t > 255)
+                t = 255;
+
+            res[y * 8 + x] = t;
         }
     }
 }
+#else
+/* int_idct_pass() */
+static inline void int_idct_pass(
+        const int32_t *in,
+        int32_t *out,
+        uint8_t shift) {
+    const int32_t half = (1 << (shift - 1));
+
+    for (uint8_t c = 0; c < 8; c++) {
+        /* Even part */
+        int32_t z2 = in[8 * 2 + c];
+        int32_t z3 = in[8 * 6 + c];
+        int32_t z1 = (z2 + z3) * JPEG_FIX_0_541196100;
+
+        int32_t tmp2 = (z1 - z3 * JPEG_FIX_1_847759065);
+        int32_t tmp3 = (z1 + z2 * JPEG_FIX_0_765366865);
+
+        z2 = in[8 * 0 + c];
+        z3 = in[8 * 4 + c];
+
+        int32_t tmp0 = ((z2 + z3) * (1 << JPEG_IDCT_CONST_BITS));
+        int32_t tmp1 = ((z2 - z3) * (1 << JPEG_IDCT_CONST_BITS));
+
+        const int32_t tmp10 = (tmp0 + tmp3);
+        const int32_t tmp13 = (tmp0 - tmp3);
+        const int32_t tmp11 = (tmp1 + tmp2);
+        const int32_t tmp12 = (tmp1 - tmp2);
+
+        /* Odd part */
+        tmp0 = in[8 * 7 + c];
+        tmp1 = in[8 * 5 + c];
+        tmp2 = in[8 * 3 + c];
+        tmp3 = in[8 * 1 + c];
+
+        z1 = (tmp0 + tmp3);
+        z2 = (tmp1 + tmp2);
+        z3 = (tmp0 + tmp2);
+
+        int32_t z4 = (tmp1 + tmp3);
+        const int32_t z5 = (z3 + z4) * JPEG_FIX_1_175875602;
+
+        tmp0 *= JPEG_FIX_0_298631336;
+        tmp1 *= JPEG_FIX_2_053119869;
+        tmp2 *= JPEG_FIX_3_072711026;
+        tmp3 *= JPEG_FIX_1_501321110;
+        z1 *= -JPEG_FIX_0_899976223;
+        z2 *= -JPEG_FIX_2_562915447;
+        z3 = (z5 - z3 * JPEG_FIX_1_961570560);
+        z4 = (z5 - z4 * JPEG_FIX_0_390180644);
+
+        tmp0 += (z1 + z3);
+        tmp1 += (z2 + z4);
+        tmp2 += (z2 + z3);
+        tmp3 += (z1 + z4);
+
+        /* Store transposed */
+        out[c * 8 + 0] = ((tmp10 + tmp3 + half) >> shift);
+        out[c * 8 + 7] = ((tmp10 - tmp3 + half) >> shift);
+        out[c * 8 + 1] = ((tmp11 + tmp2 + half) >> shift);
+        out[c * 8 + 6] = ((tmp11 - tmp2 + half) >> shift);
+        out[c * 8 + 2] = ((tmp12 + tmp1 + half) >> shift);
+        out[c * 8 + 5] = ((tmp12 - tmp1 + half) >> shift);
+        out[c * 8 + 3] = ((tmp13 + tmp0 + half) >> shift);
+        out[c * 8 + 4] = ((tmp13 - tmp0 + half) >> shift);
+    }
+}
+
+/*************************************************************************************************/
+
+/* int_idct_pass_sparse() */
+static inline void int_idct_pass_sparse(
+        const int32_t *in,
+        int32_t *out,
+        uint8_t shift,
+        uint8_t cols) {
+    const int32_t half = (1 << (shift - 1));
+
+    for (uint8_t c = 0; c < cols; c++) {
+        /* Even part */
+        const int32_t z2 = in[8 * 2 + c];
+        const int32_t z1 = z2 * JPEG_FIX_0_541196100;
+
+        const int32_t tmp0 = (in[8 * 0 + c] * (1 << JPEG_IDCT_CONST_BITS));
+        const int32_t tmp2 = z1;
+        const int32_t tmp3 = (z1 + z2 * JPEG_FIX_0_765366865);
+
+        const int32_t tmp10 = (tmp0 + tmp3);
+        const int32_t tmp13 = (tmp0 - tmp3);
+        const int32_t tmp11 = (tmp0 + tmp2);
+        const int32_t tmp12 = (tmp0 - tmp2);
+
+        /* Odd part */
+        const int32_t in3 = in[8 * 3 + c];
+        const int32_t in1 = in[8 * 1 + c];
+        const int32_t z5 = (in3 + in1) * JPEG_FIX_1_175875602;
+
+        const int32_t o1 = (in1 * -JPEG_FIX_0_899976223);
+        const int32_t o2 = (in3 * -JPEG_FIX_2_562915447);
+        const int32_t o3 = (z5 - in3 * JPEG_FIX_1_961570560);
+        const int32_t o4 = (z5 - in1 * JPEG_FIX_0_390180644);
+
+        const int32_t odd0 = (o1 + o3);
+        const int32_t odd1 = (o2 + o4);
+        const int32_t odd2 = (in3 * JPEG_FIX_3_072711026 + o2 + o3);
+        const int32_t odd3 = (in1 * JPEG_FIX_1_501321110 + o1 + o4);
+
+        /* Store transposed */
+        out[c * 8 + 0] = ((tmp10 + odd3 + half) >> shift);
+        out[c * 8 + 7] = ((tmp10 - odd3 + half) >> shift);
+        out[c * 8 + 1] = ((tmp11 + odd2 + half) >> shift);
+        out[c * 8 + 6] = ((tmp11 - odd2 + half) >> shift);
+        out[c * 8 + 2] = ((tmp12 + odd1 + half) >> shift);
+        out[c * 8 + 5] = ((tmp12 - odd1 + half) >> shift);
+        out[c * 8 + 3] = ((tmp13 + odd0 + half) >> shift);
+        out[c * 8 + 4] = ((tmp13 - odd0 + half) >> shift);
+    }
+
+    if (cols < 8)
+        memset((out + cols * 8), 0, sizeof(int32_t) * (8 - cols) * 8);
+}
+
+/*************************************************************************************************/
+
+/* int_idct_8x8() */
+static void int_idct_8x8(
+        lrpt_decoder_jpeg_t *jpeg,
+        uint8_t *res,
+        const int32_t *in,
+        uint8_t last) {
+    /* Flat block, both passes just descale DC coefficient */
+    if (last == 0) {
+        int32_t t = (((in[0] + 4) >> 3) + 128);
+
+        t = (t < 0) ? 0 : t;
+        t = (t > 255) ? 255 : t;
+
+        memset(res, t, sizeof(uint8_t) * 64);
+        jpeg->idct_dc_cnt++;
+
+        return;
+    }
+
+    int32_t ws[64], out[64];
+
+    /* Columns are transformed first, then rows. Every pass transposes data so after the second one
+     * it's back in natural order. Extra 3 bits of descaling are for 1/8 normalization
+     */
+    if (last <= JPEG_IDCT_SPARSE_LAST) {
+        /* Only 4 columns are non-zero and after transposition only 4 rows are */
+        int_idct_pass_sparse(in, ws, (JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS), 4);
+        int_idct_pass_sparse(ws, out, (JPEG_IDCT_CONST_BITS + JPEG_IDCT_PASS1_BITS + 3), 8);
+        jpeg->idct_sparse_cnt++;
+    }
+    else {
+        int_idct_pass(in, ws, (JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS));
+        int_idct_pass(ws, out, (JPEG_IDCT_CONST_BITS + JPEG_IDCT_PASS1_BITS + 3));
+        jpeg->idct_full_cnt++;
+    }
+
+    /* Level shift and saturation */
+    for (uint8_t i = 0; i < 64; i++) {
+        int32_t t = (out[i] + 128);
+
+        t = (t < 0) ? 0 : t;
+        t = (t > 255) ? 255 : t;
+
+        res[i] = t;
+    }
+}
+#endif
 
 /*************************************************************************************************/
 
@@ -166,11 +520,44 @@ static void fill_dqt_by_q(
         f = 200.0 - 2.0 * q;
 
     for (uint8_t i = 0; i < 64; i++) {
-        dqt[i] = round(f / 100.0 * JPEG_STD_QUANT_TBL[i]);
+        /* Quality above 100 gives negative factor, such entries are clamped too */
+        const double v = round(f / 100.0 * JPEG_STD_QUANT_TBL[JPEG_NATURAL_TBL[i]]);
+
+        dqt[i] = (v < 1.0) ? 1 : v;
+    }
+}
+
+/*************************************************************************************************/
+
+/* dqt_by_q() */
+static const uint16_t *dqt_by_q(
+        lrpt_decoder_jpeg_t *jpeg,
+        uint8_t q) {
+    /* Every quality from 100 up gives the same table of ones */
+    const uint8_t i = (q < JPEG_DQT_Q_MAX) ? q : JPEG_DQT_Q_MAX;
 
-        if (dqt[i] < 1)
-            dqt[i] = 1;
+    if (!jpeg->dqt_ready[i]) {
+        fill_dqt_by_q(jpeg->dqt[i], i);
+        jpeg->dqt_ready[i] = true;
     }
+
+    return jpeg->dqt[i];
+}
+
+/*************************************************************************************************/
+
+/* dequantize() */
+static inline int32_t dequantize(
+        int32_t c,
+        uint16_t dqt) {
+    c *= dqt;
+
+#ifndef LIBLRPT_JPEG_FLOAT_IDCT
+    c = (c < -JPEG_IDCT_COEFF_MAX) ? -JPEG_IDCT_COEFF_MAX : c;
+    c = (c > JPEG_IDCT_COEFF_MAX) ? JPEG_IDCT_COEFF_MAX : c;
+#endif
+
+    return c;
 }
 
 /*************************************************************************************************/
@@ -232,15 +619,22 @@ static bool progress_image(
     jpeg->cur_y = 8 * ((pck_cnt - jpeg->first_pck) / 43);
 
     if ((jpeg->cur_y > jpeg->last_y) || !jpeg->progressed) {
-        decoder->channel_image_height = (jpeg->cur_y + 8);
+        const size_t channel_image_height = (jpeg->cur_y + 8);
+
+        /* Grow image when it's full. Height is at least doubled so reallocations and copying
+         * are amortized over the pass
+         */
+        const size_t height = lrpt_image_height(decoder->image);
+
+        if (channel_image_height > height) {
+            const size_t new_height =
+                ((2 * height) > channel_image_height) ? (2 * height) : channel_image_height;
 
-        /* TODO test it well on model height */
-        /* Grow image if we have (for whatever reason) reached upper limit of its height */
-        if (decoder->channel_image_height > lrpt_image_height(decoder->image)) {
-            if (!lrpt_image_set_height(decoder->image, decoder->channel_image_height, NULL))
+            if (!lrpt_image_set_height(decoder->image, new_height, NULL))
                 return false;
         }
 
+        decoder->channel_image_height = channel_image_height;
         jpeg->progressed = true;
     }
 
@@ -251,28 +645,172 @@ static bool progress_image(
 
 /*************************************************************************************************/
 
+/* decode_packet() */
+static uint8_t decode_packet(
+        lrpt_decoder_jpeg_t *jpeg,
+        const uint8_t *p,
+        size_t len,
+        uint8_t q,
+        uint8_t *pix) {
+    lrpt_decoder_bitop_t r;
+    lrpt_decoder_bitop_reader_set(&r, p, len);
+
+    const uint16_t *dqt = dqt_by_q(jpeg, q);
+
+    int32_t prev_dc = 0;
+    int32_t dct[64];
+
+    /* This code is specific for Meteor-M2 only. For more information see section "I",
+     * http://planet.iitp.ru/spacecraft/meteor_m_n2_structure_2.pdf
+     */
+    for (uint8_t m = 0; m < JPEG_PCK_MCUS; m++) {
+        /* Longest DC code with its value bits takes 20 bits so one refill is enough */
+        lrpt_decoder_bitop_buf_refill(&r);
+
+        const uint16_t dc = lrpt_decoder_huffman_get_dc(lrpt_decoder_bitop_buf_peek_n_bits(&r, 16));
+
+        if (dc == 0)
+            return m;
+
+        lrpt_decoder_bitop_buf_advance_n_bits(&r, (dc >> 8));
+
+        const uint8_t dc_cat = (dc & 0x0F);
+        const uint32_t n = (dc_cat == 0) ? 0 : lrpt_decoder_bitop_buf_pop_n_bits(&r, dc_cat);
+
+        prev_dc += map_range(dc_cat, n);
+
+        /* Only non-zero coefficients are stored below, dequantized and in natural order */
+        memset(dct, 0, sizeof(int32_t) * 64);
+        dct[0] = dequantize(prev_dc, dqt[0]);
+
+        uint8_t k = 1;
+        uint8_t last = 0; /* Last non-zero coefficient (in zigzag order) */
+
+        while (k < 64) {
+            /* Longest AC code with its value bits takes 26 bits so one refill is enough */
+            lrpt_decoder_bitop_buf_refill(&r);
+
+            /* Most of codes are resolved by first-level table, the rest take slow path */
+            uint16_t ac = HUFF_AC_LUT[lrpt_decoder_bitop_buf_peek_n_bits(&r, HUFF_AC_LUT_BITS)];
+
+            if (ac == 0) {
+                ac = lrpt_decoder_huffman_get_ac(lrpt_decoder_bitop_buf_peek_n_bits(&r, 16));
+
+                if (ac == 0)
+                    return m;
+            }
+
+            lrpt_decoder_bitop_buf_advance_n_bits(&r, (ac >> 8));
+
+            const uint8_t ac_run = ((ac >> 4) & 0x0F);
+            const uint8_t ac_size = (ac & 0x0F);
+
+            /* End of block */
+            if ((ac_run == 0) && (ac_size == 0))
+                break;
+
+            k += ac_run;
+
+            /* Zero size is a run of 16 zeros, they're already in place */
+            if (ac_size != 0) {
+                const int32_t val = map_range(ac_size, lrpt_decoder_bitop_buf_pop_n_bits(&r, ac_size));
+
+                /* Corrupted data can run past the end of block, drop such coefficients */
+                if (k < 64) {
+                    dct[JPEG_NATURAL_TBL[k]] = dequantize(val, dqt[k]);
+                    last = k;
+                }
+            }
+
+            k++;
+        }
+
+        lrpt_decoder_jpeg_idct_8x8(jpeg, (pix + m * 64), dct, last);
+    }
+
+    return JPEG_PCK_MCUS;
+}
+
+/*************************************************************************************************/
+
 /* fill_pix() */
 static void fill_pix(
         lrpt_decoder_t *decoder,
-        double *img_dct,
+        const uint8_t *pix,
         uint16_t apid,
         uint8_t mcu_id,
-        uint8_t m) {
-    for (uint8_t i = 0; i < 64; i++) {
-        int32_t t = round(img_dct[i] + 128.0);
+        uint8_t n) {
+    if (n == 0)
+        return;
+
+    const size_t width = decoder->channel_image_width;
+    uint8_t *channel = decoder->image->channels[apid - 64];
 
-        if (t < 0)
-            t = 0;
+    /* Offsets past the image end are skipped. Corrupted MCU ID can place MCU past the right edge,
+     * such rows wrap to the next line just as pixel offset does
+     */
+    if (channel) {
+        const size_t size = (lrpt_image_height(decoder->image) * width);
 
-        if (t > 255)
-            t = 255;
+        for (uint8_t y = 0; y < 8; y++) {
+            const size_t row = ((decoder->jpeg->cur_y + y) * width);
 
-        uint16_t x = ((mcu_id + m) * 8 + i % 8);
-        uint16_t y = (decoder->jpeg->cur_y + i / 8);
-        size_t off = (x + y * decoder->channel_image_width);
+            for (uint8_t m = 0; m < n; m++) {
+                const size_t off = (row + (mcu_id + m) * 8);
 
-        lrpt_image_set_px(decoder->image, apid, off, t);
-        decoder->pxls_count[apid - 64] = (off + 1); /* Current offset is a pixel count */
+                if ((off + 8) <= size)
+                    memcpy((channel + off), (pix + m * 64 + y * 8), sizeof(uint8_t) * 8);
+            }
+        }
+    }
+
+    /* Offset of the last pixel is a pixel count */
+    decoder->pxls_count[apid - 64] =
+        ((mcu_id + n) * 8 + (decoder->jpeg->cur_y + 7) * width);
+}
+
+/*************************************************************************************************/
+
+/* report_rows() */
+static void report_rows(
+        lrpt_decoder_t *decoder,
+        uint16_t apid,
+        size_t y) {
+    const size_t width = decoder->channel_image_width;
+    const uint8_t *channel = decoder->image->channels[apid - 64];
+
+    /* Row is always inside image as it only grows, check it anyway */
+    if (!decoder->rows_cb || !channel || ((y + 8) > lrpt_image_height(decoder->image)))
+        return;
+
+    decoder->rows_cb(apid, (channel + y * width), y, 8, width, decoder->rows_cb_data);
+}
+
+/*************************************************************************************************/
+
+/* track_rows() */
+static void track_rows(
+        lrpt_decoder_t *decoder,
+        uint16_t apid,
+        uint8_t mcu_id,
+        uint8_t n) {
+    lrpt_decoder_jpeg_t *jpeg = decoder->jpeg;
+    const uint8_t ch = (apid - 64);
+
+    if (n == 0)
+        return;
+
+    /* Previous row won't get any more pixels, its rightmost MCUs were lost */
+    if (jpeg->rows_pending[ch] && (jpeg->rows_y[ch] != jpeg->cur_y))
+        report_rows(decoder, apid, jpeg->rows_y[ch]);
+
+    if (((mcu_id + n) * 8) >= decoder->channel_image_width) {
+        report_rows(decoder, apid, jpeg->cur_y);
+        jpeg->rows_pending[ch] = false;
+    }
+    else {
+        jpeg->rows_y[ch] = jpeg->cur_y;
+        jpeg->rows_pending[ch] = true;
     }
 }
 
@@ -286,6 +824,7 @@ lrpt_decoder_jpeg_t *lrpt_decoder_jpeg_init(void) {
     if (!jpeg)
         return NULL;
 
+#ifdef LIBLRPT_JPEG_FLOAT_IDCT
     /* Initialize DCT tables */
     for (uint8_t y = 0; y < 8; y++)
         for (uint8_t x = 0; x < 8; x++)
@@ -295,6 +834,7 @@ lrpt_decoder_jpeg_t *lrpt_decoder_jpeg_init(void) {
 
     for (uint8_t i = 1; i < 8; i++)
         jpeg->alpha[i] = 1.0;
+#endif
 
     /* Set internal state variables */
     jpeg->first = true;
@@ -305,6 +845,18 @@ lrpt_decoder_jpeg_t *lrpt_decoder_jpeg_init(void) {
     jpeg->first_pck = 0;
     jpeg->prev_pck = 0;
 
+    jpeg->idct_dc_cnt = 0;
+    jpeg->idct_sparse_cnt = 0;
+    jpeg->idct_full_cnt = 0;
+
+    for (uint8_t i = 0; i < 6; i++) {
+        jpeg->rows_y[i] = 0;
+        jpeg->rows_pending[i] = false;
+    }
+
+    for (uint8_t i = 0; i <= JPEG_DQT_Q_MAX; i++)
+        jpeg->dqt_ready[i] = false;
+
     return jpeg;
 }
 
@@ -320,92 +872,48 @@ void lrpt_decoder_jpeg_deinit(lrpt_decoder_jpeg_t *jpeg) {
 
 /*************************************************************************************************/
 
+/* lrpt_decoder_jpeg_idct_8x8() */
+void lrpt_decoder_jpeg_idct_8x8(
+        lrpt_decoder_jpeg_t *jpeg,
+        uint8_t *res,
+        const int32_t *in,
+        uint8_t last) {
+#ifdef LIBLRPT_JPEG_FLOAT_IDCT
+    (void)last; /* Used by fixed-point IDCT shortcuts only */
+
+    flt_idct_8x8(jpeg, res, in);
+#else
+    int_idct_8x8(jpeg, res, in, last);
+#endif
+}
+
+/*************************************************************************************************/
+
 /* lrpt_decoder_jpeg_decode_mcus() */
 bool lrpt_decoder_jpeg_decode_mcus(
         lrpt_decoder_t *decoder,
-        uint8_t *p,
+        const uint8_t *p,
+        size_t len,
         uint16_t apid,
         uint16_t pck_cnt,
         uint8_t mcu_id,
         uint8_t q) {
-    lrpt_decoder_bitop_t b;
-    lrpt_decoder_bitop_writer_set(&b, p);
-
     if (!progress_image(decoder, apid, mcu_id, pck_cnt))
         return false;
 
-    uint16_t dqt[64];
-    fill_dqt_by_q(dqt, q);
-
-    int32_t prev_dc = 0;
-    int32_t zdct[64];
-    int32_t dct[64];
-    double img_dct[64];
-
-    /* This code is specific for Meteor-M2 only. For more information see section "I",
-     * http://planet.iitp.ru/spacecraft/meteor_m_n2_structure_2.pdf
-     */
-    for (uint8_t m = 0; m < 14; m++) { /* Each packet has 14 MCUs */
-        /* TODO use true/false and pass by pointer */
-        int32_t dc_cat =
-            lrpt_decoder_huffman_get_dc(decoder->huff, lrpt_decoder_bitop_peek_n_bits(&b, 16));
-
-        if (dc_cat == -1)
-            return false;
-
-        lrpt_decoder_bitop_advance_n_bits(&b, JPEG_DC_CAT_OFFSET[dc_cat]);
-
-        uint16_t n = lrpt_decoder_bitop_pop_n_bits(&b, dc_cat);
-
-        zdct[0] = lrpt_decoder_huffman_map_range(dc_cat, n) + prev_dc;
-        prev_dc = zdct[0];
-
-        uint8_t k = 1;
-
-        while (k < 64) {
-            /* TODO use true/false and pass by pointer */
-            int32_t ac =
-                lrpt_decoder_huffman_get_ac(decoder->huff, lrpt_decoder_bitop_peek_n_bits(&b, 16));
-
-            if (ac == -1)
-                return false;
-
-            uint8_t ac_len = decoder->huff->ac_tbl[ac].len;
-            uint16_t ac_size = decoder->huff->ac_tbl[ac].size;
-            uint16_t ac_run = decoder->huff->ac_tbl[ac].run;
-
-            lrpt_decoder_bitop_advance_n_bits(&b, ac_len);
-
-            if ((ac_run == 0) && (ac_size == 0)) {
-                for (uint8_t i = k; i < 64; i++)
-                    zdct[i] = 0;
-
-                break;
-            }
-
-            for (uint16_t i = 0; i < ac_run; i++) {
-                zdct[k] = 0;
-                k++;
-            }
-
-            if (ac_size != 0) {
-                n = lrpt_decoder_bitop_pop_n_bits(&b, ac_size);
-                zdct[k] = lrpt_decoder_huffman_map_range(ac_size, n);
-            }
-            else if (ac_run == 15)
-                zdct[k] = 0;
+    /* Channel is allocated on the first packet of APID */
+    if (!lrpt_image_add_channel(decoder->image, apid, NULL))
+        return false;
 
-            k++;
-        }
+    uint8_t pix[896]; /* 64 * JPEG_PCK_MCUS */
 
-        for (uint8_t i = 0; i < 64; i++)
-            dct[i] = zdct[JPEG_ZZ_TBL[i]] * dqt[i];
+    /* MCUs decoded before an error are still placed */
+    const uint8_t n = decode_packet(decoder->jpeg, p, len, q, pix);
 
-        flt_idct_8x8(decoder->jpeg, img_dct, dct);
-        fill_pix(decoder, img_dct, apid, mcu_id, m);
-    }
+    fill_pix(decoder, pix, apid, mcu_id, n);
+    track_rows(decoder, apid, mcu_id, n);
 
-    return true;
+    return (n == JPEG_PCK_MCUS);
 }
 
 /*************************************************************************************************/
@@ -57,10 +57,31 @@ typedef struct lrpt_decoder_jpeg__ {
     /** @} */
 
     /** @{ */
-    /** Needed for discrete cosine transform */
+    /** Number of blocks transformed by DC-only, sparse (4x4) and full IDCT paths */
+    size_t idct_dc_cnt;
+    size_t idct_sparse_cnt;
+    size_t idct_full_cnt;
+    /** @} */
+
+    /** @{ */
+    /** Per-channel first line of MCU row which has decoded pixels but wasn't reported yet */
+    uint16_t rows_y[6];
+    bool rows_pending[6];
+    /** @} */
+
+    /** @{ */
+    /** Quantization tables (in zigzag order) cached by quality factor */
+    uint16_t dqt[101][64]; /* JPEG_DQT_Q_MAX + 1 */
+    bool dqt_ready[101]; /* JPEG_DQT_Q_MAX + 1 */
+    /** @} */
+
+#ifdef LIBLRPT_JPEG_FLOAT_IDCT
+    /** @{ */
+    /** Needed for reference floating-point discrete cosine transform */
     double cosine[8][8];
     double alpha[8];
     /** @} */
+#endif
 } lrpt_decoder_jpeg_t;
 
 /*************************************************************************************************/
@@ -77,10 +98,26 @@ lrpt_decoder_jpeg_t *lrpt_decoder_jpeg_init(void);
  */
 void lrpt_decoder_jpeg_deinit(lrpt_decoder_jpeg_t *jpeg);
 
+/** Perform inverse discrete cosine transform for 8x8 block.
+ *
+ * Fixed-point or reference floating-point transform is used depending on build configuration.
+ *
+ * \param jpeg Pointer to the JPEG decoder object.
+ * \param[out] res Resulting pixels.
+ * \param in Dequantized DCT coefficients (in natural order).
+ * \param last Last non-zero coefficient index (in zigzag order).
+ */
+void lrpt_decoder_jpeg_idct_8x8(
+        lrpt_decoder_jpeg_t *jpeg,
+        uint8_t *res,
+        const int32_t *in,
+        uint8_t last);
+
 /** Perform decoding of input MCUs.
  *
  * \param decoder Pointer to the decoder object.
  * \param p Input data.
+ * \param len Input data length.
  * \param apid APID number.
  * \param pck_cnt Number of packets.
  * \param mcu_id ID of current MCU.
@@ -90,7 +127,8 @@ void lrpt_decoder_jpeg_deinit(lrpt_decoder_jpeg_t *jpeg);
  */
 bool lrpt_decoder_jpeg_decode_mcus(
         lrpt_decoder_t *decoder,
-        uint8_t *p,
+        const uint8_t *p,
+        size_t len,
         uint16_t apid,
         uint16_t pck_cnt,
         uint8_t mcu_id,
@@ -59,12 +59,14 @@ static void parse_70(
  *
  * \param decoder Pointer to the decoder object.
  * \param p Data buffer.
+ * \param len Data length.
  * \param apid APID number.
  * \param pck_cnt Packet count.
  */
 static void parse_img(
         lrpt_decoder_t *decoder,
         uint8_t *p,
+        uint16_t len,
         uint16_t apid,
         uint16_t pck_cnt);
 
@@ -114,6 +116,7 @@ static void parse_70(
 static void parse_img(
         lrpt_decoder_t *decoder,
         uint8_t *p,
+        uint16_t len,
         uint16_t apid,
         uint16_t pck_cnt) {
     if (
@@ -127,7 +130,10 @@ static void parse_img(
         const uint8_t mcu_id = p[0];
         const uint8_t q = p[5];
 
-        lrpt_decoder_jpeg_decode_mcus(decoder, p + 6, apid, pck_cnt, mcu_id, q);
+        /* 6 bytes of MCU header precede entropy-coded data */
+        const uint16_t mcus_len = (len > 6) ? (len - 6) : 0;
+
+        lrpt_decoder_jpeg_decode_mcus(decoder, p + 6, mcus_len, apid, pck_cnt, mcu_id, q);
     }
 }
 
@@ -143,11 +149,16 @@ static void parse_apid(
     uint16_t apid = (((p[0] << 8) | p[1]) & 0x07FF);
     uint16_t pck_cnt = (((p[2] << 8) | p[3]) & 0x3FFF);
 
-    /* uint16_t pck_len = ((p[4] << 8) | p[5]); */
+    uint16_t pck_len = ((p[4] << 8) | p[5]);
+
+    /* Packet data field is (pck_len + 1) bytes long and starts after 6 bytes of primary header,
+     * so user data length is (pck_len + 1 + 6 - 14)
+     */
+    const uint16_t data_len = (pck_len > 6) ? (pck_len - 7) : 0;
 
     /* 14 is an offset to get "User data" block directly */
     if ((apid >= 64) && (apid <= 69))
-        parse_img(decoder, p + 14, apid, pck_cnt);
+        parse_img(decoder, p + 14, data_len, apid, pck_cnt);
     else if (apid == 70)
         parse_70(decoder, p + 14);
 }
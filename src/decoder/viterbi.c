@@ -33,7 +33,6 @@
 #include "viterbi.h"
 
 #include "bitop.h"
-#include "correlator.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -43,33 +42,33 @@
 /*************************************************************************************************/
 
 static const uint8_t VITERBI_STATES_NUM = 128;
-static const uint8_t VITERBI_PAIR_OUTPUTS_NUM = 16; /* 2 ^ (2 * rate), rate = 2 */
-static const uint8_t VITERBI_PAIR_KEYS_NUM = 64; /* 2 ^ (order - 1), order = 7 */
+static const uint8_t VITERBI_BUTTERFLIES_NUM = 32; /* 2 ^ (order - 2), order = 7 */
+static const uint8_t VITERBI_DECISION_BYTES = 8; /* (2 ^ (order - 1)) / 8, order = 7 */
 static const uint8_t VITERBI_TRACEBACK_MIN = 35; /* (5 * 7) */
 static const uint8_t VITERBI_TRACEBACK_LENGTH = 105; /* (15 * 7) */
 static const uint8_t VITERBI_POLYA = 0x4F; /* Viterbi polynomial A (G1), 01001111 */
 static const uint8_t VITERBI_POLYB = 0x6D; /* Viterbi polynomial B (G2), 01101101 */
+static const uint8_t VITERBI_ORDER = 7;
 static const uint16_t VITERBI_FRAME_BITS = 8192; /* (DECODER_SOFT_FRAME_LEN / rate), rate = 2 */
 static const uint8_t VITERBI_HIGH_BIT = 64;
-static const uint8_t VITERBI_NUM_ITER = (VITERBI_HIGH_BIT * 2);
 static const uint8_t VITERBI_RENORM_INTERVAL = 128; /* 65536 / (2 * 256) */
-static const uint32_t VITERBI_DIST_TBL_X = 65536;
-static const uint8_t VITERBI_DIST_TBL_Y = 4;
+
+const uint8_t VITERBI_FLUSH_SOFT_LEN = 64; /* Sync word of the next frame */
 
 /*************************************************************************************************/
 
-/** Find distance between hard and soft symbols.
+/** Find distances between soft symbol and all hard symbols.
+ *
+ * Results are stored in the \c distances field.
  *
- * \param hard Hard symbol.
+ * \param vit Pointer to the Viterbi decoder object.
  * \param soft_y0 LSB of soft symbol.
  * \param soft_y1 MSB of soft symbol.
- *
- * \return Metric distance between hard and soft symbols.
  */
-static uint16_t metric_soft_distance(
-        uint8_t hard,
-        uint8_t soft_y0,
-        uint8_t soft_y1);
+static inline void metric_soft_distances(
+        lrpt_decoder_viterbi_t *vit,
+        int8_t soft_y0,
+        int8_t soft_y1);
 
 /** Perform error buffers swapping.
  *
@@ -78,13 +77,6 @@ static uint16_t metric_soft_distance(
 static inline void swap_error_buffers(
         lrpt_decoder_viterbi_t *vit);
 
-/** Fill up pair lookup distances.
- *
- * \param vit Pointer to the Viterbi decoder object.
- */
-static void fill_pair_lookup_dists(
-        lrpt_decoder_viterbi_t *vit);
-
 /** Find best path in history buffer with set search interval.
  *
  * \param vit Pointer to the Viterbi decoder object.
@@ -134,15 +126,6 @@ static void viterbi_inner(
         lrpt_decoder_viterbi_t *vit,
         const int8_t *input);
 
-/** Viterbi tail code.
- *
- * \param vit Pointer to the Viterbi decoder object.
- * \param input Encoded soft symbols data.
- */
-static void viterbi_tail(
-        lrpt_decoder_viterbi_t *vit,
-        const int8_t *input);
-
 /** Perform convolutional Viterbi decoding.
  *
  * \param vit Pointer to the Viterbi decoder.
@@ -156,65 +139,18 @@ static void convolutional_decode(
 
 /*************************************************************************************************/
 
-/* metric_soft_distance() */
-static uint16_t metric_soft_distance(
-        uint8_t hard,
-        uint8_t soft_y0,
-        uint8_t soft_y1) {
-    const int16_t mag = 255;
-    int16_t soft_x0, soft_x1;
-
-    switch (hard & 0x03) {
-        case 0:
-            {
-                soft_x0 = mag;
-                soft_x1 = mag;
-            }
-
-            break;
-
-        case 1:
-            {
-                soft_x0 = -mag;
-                soft_x1 =  mag;
-            }
-
-            break;
-
-        case 2:
-            {
-                soft_x0 =  mag;
-                soft_x1 = -mag;
-            }
-
-            break;
-
-        case 3:
-            {
-                soft_x0 = -mag;
-                soft_x1 = -mag;
-            }
-
-            break;
-
-        default:
-            {
-                soft_x0 = 0;
-                soft_x1 = 0;
-            }
-
-            break;
-    }
-
-    /* In both cases explicit cast is needed to prevent unwanted unsigned underflow */
-
-    /* Manhattan distance */
-    return (abs((int8_t)soft_y0 - soft_x0) + abs((int8_t)soft_y1 - soft_x1));
-
-    /* Euclidean distance, results are not much better or worser.
-     * Needs math.h for sqrt() and pow().
+/* metric_soft_distances() */
+static inline void metric_soft_distances(
+        lrpt_decoder_viterbi_t *vit,
+        int8_t soft_y0,
+        int8_t soft_y1) {
+    /* Manhattan distance to the hard symbols of +-255 magnitude. Soft symbols never exceed it
+     * so it's just (255 -+ y0) + (255 -+ y1).
      */
-    /* return sqrt(pow((int8_t)soft_y0 - soft_x0, 2.0) + pow((int8_t)soft_y1 - soft_x1, 2.0)); */
+    vit->distances[0] = 510 - soft_y0 - soft_y1;
+    vit->distances[1] = 510 + soft_y0 - soft_y1;
+    vit->distances[2] = 510 - soft_y0 + soft_y1;
+    vit->distances[3] = 510 + soft_y0 + soft_y1;
 }
 
 /*************************************************************************************************/
@@ -229,20 +165,6 @@ static inline void swap_error_buffers(
 
 /*************************************************************************************************/
 
-/* fill_pair_lookup_dists() */
-static void fill_pair_lookup_dists(
-        lrpt_decoder_viterbi_t *vit) {
-    for (uint8_t i = 1; i < vit->pair_outputs_len; i++) {
-        const uint16_t c = vit->pair_outputs[i];
-        const uint16_t i0 = (c & 0x03);
-        const uint16_t i1 = (c >> 2);
-
-        vit->pair_distances[i] = ((vit->distances[i1] << 16) | vit->distances[i0]);
-    }
-}
-
-/*************************************************************************************************/
-
 /* history_buffer_search() */
 static uint8_t history_buffer_search(
         const lrpt_decoder_viterbi_t *vit,
@@ -278,66 +200,34 @@ static void history_buffer_traceback(
         lrpt_decoder_viterbi_t *vit,
         uint8_t bestpath,
         uint8_t min_traceback_length) {
+    const uint8_t *history = vit->history;
+    const uint16_t fetched_len = vit->len - min_traceback_length;
     uint8_t index = vit->hist_index;
 
-    for (uint8_t i = 0; i < min_traceback_length; i++) {
+    /* Fetched bits in chronological order, MSB first */
+    uint64_t fetched[3] = { 0, 0, 0 }; /* (VITERBI_TRACEBACK_MIN + VITERBI_TRACEBACK_LENGTH) bits */
+
+    for (uint16_t i = 0; i < vit->len; i++) {
         if (index == 0)
             index = VITERBI_TRACEBACK_MIN + VITERBI_TRACEBACK_LENGTH - 1;
         else
             index--;
 
-        const uint8_t history =
-            vit->history[index * VITERBI_STATES_NUM + bestpath];
+        const uint8_t decisions = history[index * VITERBI_DECISION_BYTES + (bestpath & 0x07)];
+        const uint8_t pathbit = ((decisions >> (bestpath >> 3)) & 0x01);
 
-        uint8_t pathbit;
+        bestpath = (bestpath | (pathbit * VITERBI_HIGH_BIT)) >> 1;
 
-        if (history != 0)
-            pathbit = VITERBI_HIGH_BIT;
-        else
-            pathbit = 0;
+        if (i >= min_traceback_length) {
+            const uint16_t pos = (vit->len - 1 - i);
 
-        bestpath = (bestpath | pathbit) >> 1;
+            fetched[pos >> 6] |= ((uint64_t)pathbit << (63 - (pos & 0x3F)));
+        }
     }
 
-    uint8_t prefetch_index = index;
-
-    if (prefetch_index == 0)
-        prefetch_index = VITERBI_TRACEBACK_MIN + VITERBI_TRACEBACK_LENGTH - 1;
-    else
-        prefetch_index--;
-
-    uint16_t fetched_index = 0;
-
-    for (uint16_t i = min_traceback_length; i < vit->len; i++) {
-        index = prefetch_index;
-
-        if (prefetch_index == 0)
-            prefetch_index = VITERBI_TRACEBACK_MIN + VITERBI_TRACEBACK_LENGTH - 1;
-        else
-            prefetch_index--;
-
-        const uint8_t history =
-            vit->history[index * VITERBI_STATES_NUM + bestpath];
-
-        uint8_t pathbit;
-
-        if (history != 0)
-            pathbit = VITERBI_HIGH_BIT;
-        else
-            pathbit = 0;
+    lrpt_decoder_bitop_write_words(&(vit->bit_writer), fetched, fetched_len);
 
-        bestpath = (bestpath | pathbit) >> 1;
-
-        if (pathbit != 0)
-            vit->fetched[fetched_index] = 1;
-        else
-            vit->fetched[fetched_index] = 0;
-
-        fetched_index++;
-    }
-
-    lrpt_decoder_bitop_writer_reverse(&(vit->bit_writer), vit->fetched, fetched_index);
-    vit->len -= fetched_index;
+    vit->len -= fetched_len;
 }
 
 /*************************************************************************************************/
@@ -377,152 +267,78 @@ static void viterbi_inner(
         lrpt_decoder_viterbi_t *vit,
         const int8_t *input) {
     for (uint8_t i = 0; i < 6; i++) {
-        for (uint8_t j = 0; j < (1 << (i + 1)); j++) {
-            size_t idx = ((uint8_t)input[i * 2 + 1] << 8) + (uint8_t)input[i * 2];
+        metric_soft_distances(vit, input[i * 2], input[i * 2 + 1]);
 
-            vit->write_errors[j] =
-                vit->dist_table[vit->table[j] * VITERBI_DIST_TBL_X + idx] + vit->read_errors[j >> 1];
-        }
+        for (uint8_t j = 0; j < (1 << (i + 1)); j++)
+            vit->write_errors[j] = vit->distances[vit->table[j]] + vit->read_errors[j >> 1];
 
         swap_error_buffers(vit);
     }
 
-    for (uint16_t i = 6; i < (VITERBI_FRAME_BITS - 6); i++) {
-        for (uint8_t j = 0; j < 4; j++) {
-            size_t idx = ((uint8_t)input[i * 2 + 1] << 8) + (uint8_t)input[i * 2];
+    const uint16_t *low_masks = vit->sym_masks[0];
+    const uint16_t *high_masks = vit->sym_masks[1];
 
-            vit->distances[j] = vit->dist_table[j * VITERBI_DIST_TBL_X + idx];
+    /* Both polynomials have the first and the last taps set so the high predecessor and the odd
+     * successor invert both output symbols of the butterfly. Hence every butterfly needs two
+     * branch metrics only. Loops below are branchless and operate on local arrays so compiler
+     * is able to vectorize them.
+     */
+    uint16_t metrics[32]; /* VITERBI_BUTTERFLIES_NUM */
+    uint16_t inv_metrics[32];
+    uint16_t errors[64]; /* VITERBI_STATES_NUM / 2 */
+    uint8_t decisions[64];
+
+    const uint16_t steps = (VITERBI_FRAME_BITS + VITERBI_FLUSH_SOFT_LEN / 2);
+
+    for (uint16_t i = 6; i < steps; i++) {
+        /* Soft symbols are sign-extended so the metrics below wrap back to proper values */
+        const uint16_t soft_y0 = input[i * 2];
+        const uint16_t soft_y1 = input[i * 2 + 1];
+
+        /* Metric of low predecessor output symbol, masks negate soft symbols for set bits.
+         * Distances to the complementary symbol sum up to 1020.
+         */
+        for (uint8_t j = 0; j < VITERBI_BUTTERFLIES_NUM; j++) {
+            const uint16_t low_mask = low_masks[j];
+            const uint16_t high_mask = high_masks[j];
+
+            metrics[j] = 510 -
+                ((soft_y0 ^ low_mask) - low_mask) - ((soft_y1 ^ high_mask) - high_mask);
+            inv_metrics[j] = 1020 - metrics[j];
         }
 
-        uint8_t *history = vit->history + vit->hist_index * VITERBI_STATES_NUM;
-
-        fill_pair_lookup_dists(vit);
-
-        const uint8_t highbase = (VITERBI_HIGH_BIT >> 1);
-        uint8_t low = 0;
-        uint8_t base = 0;
-
-        for (uint8_t high = VITERBI_HIGH_BIT; high < VITERBI_NUM_ITER; high += 8) {
-            uint8_t offset = 0;
-
-            for (uint8_t base_offset = 0; base_offset < 4; base_offset++) {
-                const uint8_t low_key = vit->pair_keys[base + base_offset];
-                const uint8_t high_key = vit->pair_keys[highbase + base + base_offset];
-
-                const uint32_t low_concat_dist = vit->pair_distances[low_key];
-                const uint32_t high_concat_dist = vit->pair_distances[high_key];
-
-                const uint16_t low_past_error = vit->read_errors[base + base_offset];
-                const uint16_t high_past_error = vit->read_errors[highbase + base + base_offset];
+        const uint16_t *read_errors = vit->read_errors;
 
-                const uint16_t low_error = (low_concat_dist & 0xFFFF) + low_past_error;
-                const uint16_t high_error = (high_concat_dist & 0xFFFF) + high_past_error;
+        /* Add-compare-select, ties are resolved in favour of the low predecessor */
+        for (uint8_t j = 0; j < VITERBI_BUTTERFLIES_NUM; j++) {
+            const uint16_t low_past_error = read_errors[j];
+            const uint16_t high_past_error = read_errors[j + VITERBI_BUTTERFLIES_NUM];
 
-                const uint8_t successor = low + offset;
-                uint16_t error;
-                uint8_t history_mask;
+            const uint16_t low_error = low_past_error + metrics[j];
+            const uint16_t high_error = high_past_error + inv_metrics[j];
+            const uint16_t low_plus_one_error = low_past_error + inv_metrics[j];
+            const uint16_t high_plus_one_error = high_past_error + metrics[j];
 
-                if (low_error <= high_error) {
-                    error = low_error;
-                    history_mask = 0;
-                }
-                else {
-                    error = high_error;
-                    history_mask = 1;
-                }
+            errors[2 * j] = (high_error < low_error) ? high_error : low_error;
+            errors[2 * j + 1] = (high_plus_one_error < low_plus_one_error) ?
+                high_plus_one_error : low_plus_one_error;
 
-                vit->write_errors[successor] = error;
-                history[successor] = history_mask;
-
-                const uint8_t low_plus_one = low + offset + 1;
-
-                const uint16_t low_plus_one_error = (low_concat_dist >> 16) + low_past_error;
-                const uint16_t high_plus_one_error = (high_concat_dist >> 16) + high_past_error;
-
-                const uint8_t plus_one_successor = low_plus_one;
-                uint16_t plus_one_error;
-                uint8_t plus_one_history_mask;
-
-                if (low_plus_one_error <= high_plus_one_error) {
-                    plus_one_error = low_plus_one_error;
-                    plus_one_history_mask = 0;
-                }
-                else {
-                    plus_one_error = high_plus_one_error;
-                    plus_one_history_mask = 1;
-                }
-
-                vit->write_errors[plus_one_successor] = plus_one_error;
-                history[plus_one_successor] = plus_one_history_mask;
-
-                offset += 2;
-            }
-
-            low += 8;
-            base += 4;
+            decisions[2 * j] = (high_error < low_error) ? 0xFF : 0;
+            decisions[2 * j + 1] = (high_plus_one_error < low_plus_one_error) ? 0xFF : 0;
         }
 
-        history_buffer_process_skip(vit, 1);
-        swap_error_buffers(vit);
-    }
-}
+        memcpy(vit->write_errors, errors, sizeof(errors));
 
-/*************************************************************************************************/
+        /* Pack decisions, state s goes to bit (s / 8) of byte (s % 8) */
+        uint8_t packed[8] = { 0, 0, 0, 0, 0, 0, 0, 0 }; /* VITERBI_DECISION_BYTES */
 
-/* viterbi_tail() */
-static void viterbi_tail(
-        lrpt_decoder_viterbi_t *vit,
-        const int8_t *input) {
-    for (uint16_t i = (VITERBI_FRAME_BITS - 6); i < VITERBI_FRAME_BITS; i++) {
-        for (uint8_t j = 0; j < 4; j++) {
-            size_t idx = ((uint8_t)input[i * 2 + 1] << 8) + (uint8_t)input[i * 2];
+        for (uint8_t k = 0; k < 8; k++)
+            for (uint8_t j = 0; j < VITERBI_DECISION_BYTES; j++)
+                packed[j] |= (decisions[k * VITERBI_DECISION_BYTES + j] & (1 << k));
 
-            vit->distances[j] = vit->dist_table[j * VITERBI_DIST_TBL_X + idx];
-        }
-
-        uint8_t *history = vit->history + vit->hist_index * VITERBI_STATES_NUM;
-
-        const uint8_t skip = 1 << (7 - (VITERBI_FRAME_BITS - i));
-        const uint8_t base_skip = skip >> 1;
-
-        const uint8_t highbase = (VITERBI_HIGH_BIT >> 1);
-        uint8_t low = 0;
-        uint8_t base = 0;
-
-        for (uint8_t high = VITERBI_HIGH_BIT; high < VITERBI_NUM_ITER; high += skip) {
-            const uint8_t low_output = vit->table[low];
-            const uint8_t high_output = vit->table[high];
-
-            const uint16_t low_dist = vit->distances[low_output];
-            const uint16_t high_dist = vit->distances[high_output];
-
-            const uint16_t low_past_error = vit->read_errors[base];
-            const uint16_t high_past_error = vit->read_errors[highbase + base];
-
-            const uint16_t low_error = low_dist + low_past_error;
-            const uint16_t high_error = high_dist + high_past_error;
-
-            const uint8_t successor = low;
-            uint16_t error;
-            uint8_t history_mask;
-
-            if (low_error < high_error) {
-                error = low_error;
-                history_mask = 0;
-            }
-            else {
-                error = high_error;
-                history_mask = 1;
-            }
-
-            vit->write_errors[successor] = error;
-            history[successor] = history_mask;
-
-            low += skip;
-            base += base_skip;
-        }
+        memcpy(vit->history + vit->hist_index * VITERBI_DECISION_BYTES, packed, sizeof(packed));
 
-        history_buffer_process_skip(vit, skip);
+        history_buffer_process_skip(vit, 1);
         swap_error_buffers(vit);
     }
 }
@@ -552,9 +368,17 @@ static void convolutional_decode(
 
     /* Do Viterbi decoding */
     viterbi_inner(vit, input);
-    viterbi_tail(vit, input);
 
-    history_buffer_traceback(vit, 0, 0);
+    /* Encoder isn't terminated at the end of frame, so instead of forcing final state decoder
+     * runs through the flush symbols and traces back from the best state. Bits decoded from
+     * the flush symbols are dropped; every decision yields the bit shifted out of encoder
+     * register, (order - 1) steps behind
+     */
+    history_buffer_traceback(vit,
+            history_buffer_search(vit, 1),
+            (VITERBI_FLUSH_SOFT_LEN / 2 - (VITERBI_ORDER - 1)));
+
+    lrpt_decoder_bitop_writer_flush(&(vit->bit_writer));
 }
 
 /*************************************************************************************************/
@@ -565,22 +389,24 @@ static void convolutional_encode(
         uint8_t *input,
         uint8_t *output) {
     lrpt_decoder_bitop_t b;
-    lrpt_decoder_bitop_writer_set(&b, input);
+    lrpt_decoder_bitop_reader_set(&b, input, (VITERBI_FRAME_BITS / 8));
 
-    uint8_t sh = 0;
+    const uint8_t *table = vit->table;
+    uint64_t win = 0; /* Previous and current input words, register state is a slice of it */
 
-    for (uint16_t i = 0; i < VITERBI_FRAME_BITS; i++) {
-        sh = ((sh << 1) | lrpt_decoder_bitop_pop_n_bits(&b, 1)) & 0x7F;
+    /* Frame length is a multiple of 32 bits so input is fetched by 32 bits at once */
+    for (uint16_t i = 0; i < VITERBI_FRAME_BITS; i += 32) {
+        win = (win << 32) | lrpt_decoder_bitop_pop_n_bits(&b, 32);
 
-        if ((vit->table[sh] & 0x01) != 0)
-            output[i * 2 + 0] = 0;
-        else
-            output[i * 2 + 0] = 255;
+        uint8_t *out = (output + i * 2);
 
-        if ((vit->table[sh] & 0x02) != 0)
-            output[i * 2 + 1] = 0;
-        else
-            output[i * 2 + 1] = 255;
+        for (uint8_t j = 0; j < 32; j++) {
+            const uint8_t sh = ((win >> (31 - j)) & 0x7F);
+
+            /* Set parity bit gives 0 and cleared one gives 255 */
+            out[j * 2 + 0] = ((table[sh] & 0x01) - 1);
+            out[j * 2 + 1] = (((table[sh] >> 1) & 0x01) - 1);
+        }
     }
 }
 
@@ -597,15 +423,12 @@ lrpt_decoder_viterbi_t *lrpt_decoder_viterbi_init(void) {
     vit->ber = 0;
 
     /* NULL-init internals for safe deallocation */
-    vit->dist_table = NULL;
     vit->table = NULL;
 
-    vit->pair_outputs = NULL;
-    vit->pair_keys = NULL;
-    vit->pair_distances = NULL;
+    vit->sym_masks[0] = NULL;
+    vit->sym_masks[1] = NULL;
 
     vit->history = NULL;
-    vit->fetched = NULL;
 
     vit->errors[0] = NULL;
     vit->errors[1] = NULL;
@@ -613,15 +436,14 @@ lrpt_decoder_viterbi_t *lrpt_decoder_viterbi_init(void) {
     vit->encoded = NULL;
 
     /* Allocate internals */
-    vit->dist_table = calloc(VITERBI_DIST_TBL_X * VITERBI_DIST_TBL_Y, sizeof(uint16_t));
     vit->table = calloc(VITERBI_STATES_NUM, sizeof(uint8_t));
 
-    vit->pair_outputs = calloc(VITERBI_PAIR_OUTPUTS_NUM, sizeof(uint16_t));
-    vit->pair_keys = calloc(VITERBI_PAIR_KEYS_NUM, sizeof(uint8_t));
+    vit->sym_masks[0] = calloc(VITERBI_BUTTERFLIES_NUM, sizeof(uint16_t));
+    vit->sym_masks[1] = calloc(VITERBI_BUTTERFLIES_NUM, sizeof(uint16_t));
 
-    vit->history = calloc((VITERBI_TRACEBACK_MIN + VITERBI_TRACEBACK_LENGTH) * VITERBI_STATES_NUM,
+    vit->history = calloc(
+            (VITERBI_TRACEBACK_MIN + VITERBI_TRACEBACK_LENGTH) * VITERBI_DECISION_BYTES,
             sizeof(uint8_t));
-    vit->fetched = calloc(VITERBI_TRACEBACK_MIN + VITERBI_TRACEBACK_LENGTH, sizeof(uint8_t));
 
     vit->errors[0] = calloc(VITERBI_STATES_NUM, sizeof(uint16_t));
     vit->errors[1] = calloc(VITERBI_STATES_NUM, sizeof(uint16_t));
@@ -629,20 +451,13 @@ lrpt_decoder_viterbi_t *lrpt_decoder_viterbi_init(void) {
     vit->encoded = calloc(VITERBI_FRAME_BITS * 2, sizeof(uint8_t)); /* rate = 1/2 */
 
     /* Check for allocation problems */
-    if (!vit->dist_table || !vit->table || !vit->pair_outputs ||
-            !vit->history || !vit->fetched || !vit->pair_keys ||
-            !vit->errors[0] || !vit->errors[1] || !vit->encoded) {
+    if (!vit->table || !vit->sym_masks[0] || !vit->sym_masks[1] ||
+            !vit->history || !vit->errors[0] || !vit->errors[1] || !vit->encoded) {
         lrpt_decoder_viterbi_deinit(vit);
 
         return NULL;
     }
 
-    /* Init metric lookup table */
-    for (uint8_t i = 0; i < VITERBI_DIST_TBL_Y; i++)
-        for (uint32_t j = 0; j < VITERBI_DIST_TBL_X; j++)
-            vit->dist_table[i * VITERBI_DIST_TBL_X + j] =
-                metric_soft_distance(i, j & 0xFF, j >> 8);
-
     /* Polynomial table */
     for (uint8_t i = 0; i < VITERBI_STATES_NUM; i++) {
         vit->table[i] = 0;
@@ -653,40 +468,12 @@ lrpt_decoder_viterbi_t *lrpt_decoder_viterbi_init(void) {
             vit->table[i] = vit->table[i] | 0x02;
     }
 
-    /* Temporary allocate inverted outputs array */
-    uint8_t *inv_outputs = calloc(VITERBI_PAIR_OUTPUTS_NUM, sizeof(uint8_t));
-
-    if (!inv_outputs) {
-        lrpt_decoder_viterbi_deinit(vit);
-
-        return NULL;
-    }
-
-    /* Fill up pair keys table */
-    uint8_t oc = 1;
-
-    for (uint8_t i = 0; i < VITERBI_PAIR_KEYS_NUM; i++) {
-        uint16_t o = ((vit->table[i * 2 + 1] << 2) | vit->table[i * 2]);
-
-        if (inv_outputs[o] == 0) {
-            inv_outputs[o] = oc;
-            vit->pair_outputs[oc] = o;
-            oc++;
-        }
-
-        vit->pair_keys[i] = inv_outputs[o];
-    }
-
-    /* Free inverted outputs array */
-    free(inv_outputs);
-
-    vit->pair_outputs_len = oc;
-    vit->pair_distances = calloc(oc, sizeof(uint32_t));
-
-    if (!vit->pair_distances) {
-        lrpt_decoder_viterbi_deinit(vit);
-
-        return NULL;
+    /* Butterfly output symbol masks. Butterfly j connects states j and (j + 32) with states 2j
+     * and (2j + 1), low predecessor emits table[2j] on the way to the even successor.
+     */
+    for (uint8_t i = 0; i < VITERBI_BUTTERFLIES_NUM; i++) {
+        vit->sym_masks[0][i] = ((vit->table[i * 2] & 0x01) != 0) ? 0xFFFF : 0;
+        vit->sym_masks[1][i] = ((vit->table[i * 2] & 0x02) != 0) ? 0xFFFF : 0;
     }
 
     return vit;
@@ -705,15 +492,12 @@ void lrpt_decoder_viterbi_deinit(
     free(vit->errors[0]);
     free(vit->errors[1]);
 
-    free(vit->fetched);
     free(vit->history);
 
-    free(vit->pair_distances);
-    free(vit->pair_keys);
-    free(vit->pair_outputs);
+    free(vit->sym_masks[0]);
+    free(vit->sym_masks[1]);
 
     free(vit->table);
-    free(vit->dist_table);
 
     free(vit);
 }
@@ -723,20 +507,20 @@ void lrpt_decoder_viterbi_deinit(
 /* lrpt_decoder_viterbi_decode() */
 void lrpt_decoder_viterbi_decode(
         lrpt_decoder_viterbi_t *vit,
-        const lrpt_decoder_correlator_t *corr,
         const int8_t *input,
         uint8_t *output) {
     /* Perform convolutional decoding */
     convolutional_decode(vit, input, output);
 
-    /* Estimate signal quality. For that we should do convolutional encoding and calculate BER
-     * by means of cross-correlation
+    /* Estimate signal quality. For that we should do convolutional encoding and count input
+     * symbols whose sign disagrees with re-encoded ones (0 for negative and 255 for
+     * non-negative symbol)
      */
     convolutional_encode(vit, output, vit->encoded);
     vit->ber = 0;
 
     for (uint16_t i = 0; i < (VITERBI_FRAME_BITS * 2); i++)
-        vit->ber += corr->corr_tab[(uint8_t)input[i] * CORR_IQ_TBL_SIZE + (vit->encoded[i] ^ 0xFF)];
+        vit->ber += ((input[i] < 0) == (vit->encoded[i] != 0));
 }
 
 /*************************************************************************************************/
@@ -34,21 +34,24 @@
 /*************************************************************************************************/
 
 #include "bitop.h"
-#include "correlator.h"
 
 #include <stddef.h>
 #include <stdint.h>
 
 /*************************************************************************************************/
 
+/** Number of soft symbols past the end of frame used to flush decoder */
+extern const uint8_t VITERBI_FLUSH_SOFT_LEN;
+
+/*************************************************************************************************/
+
 /** Viterbi decoder object */
 typedef struct lrpt_decoder_viterbi__ {
     lrpt_decoder_bitop_t bit_writer; /**< Bit writer object */
 
     /** @{ */
     /** Used by history buffer */
-    uint8_t *history;
-    uint8_t *fetched;
+    uint8_t *history; /**< Packed decisions, 64 bits per step */
 
     uint16_t len;
     uint8_t hist_index;
@@ -70,17 +73,11 @@ typedef struct lrpt_decoder_viterbi__ {
     /** @{ */
     /** Distances stuff */
     uint16_t distances[4];
-    uint16_t *dist_table;
     uint8_t *table;
     /** @} */
 
-    /** @{ */
-    /** Needed for pairs lookup */
-    uint16_t *pair_outputs;
-    uint8_t *pair_keys;
-    uint32_t *pair_distances;
-    uint8_t pair_outputs_len;
-    /** @} */
+    /** Butterfly output symbol masks (LSB and MSB of low predecessor output) */
+    uint16_t *sym_masks[2];
 } lrpt_decoder_viterbi_t;
 
 /*************************************************************************************************/
@@ -100,13 +97,13 @@ void lrpt_decoder_viterbi_deinit(lrpt_decoder_viterbi_t *vit);
 /** Perform Viterbi decoding.
  *
  * \param vit Pointer to the Viterbi decoder object.
- * \param corr Pointer to the correlator object.
  * \param input Input data array.
  * \param output Output data array.
+ *
+ * \warning \p input should contain #VITERBI_FLUSH_SOFT_LEN extra symbols past the end of frame!
  */
 void lrpt_decoder_viterbi_decode(
         lrpt_decoder_viterbi_t *vit,
-        const lrpt_decoder_correlator_t *corr,
         const int8_t *input,
         uint8_t *output);
 
@@ -51,34 +51,79 @@ static const uint32_t DEINT_INTLV_BASE_LEN = DEINT_INTLV_BRANCHES * DEINT_INTLV_
 static const uint8_t DEINT_INTLV_DATA_LEN = 72; /* Number of interleaved bits */
 static const uint8_t DEINT_INTLV_SYNC_LEN = 8; /* The length of sync word (in bits) */
 static const uint8_t DEINT_INTLV_SYNCDATA = DEINT_INTLV_DATA_LEN + DEINT_INTLV_SYNC_LEN;
+static const uint16_t DEINT_INTLV_TILE_ROWS = 128; /* Rows of branches processed at once */
 
 static const uint8_t DEINT_SYNCD_DEPTH = 4; /* Number of consecutive sync words to search */
 static const uint16_t DEINT_SYNCD_BUF_MARGIN = DEINT_SYNCD_DEPTH * DEINT_INTLV_SYNCDATA;
-static const uint16_t DEINT_SYNCD_BLOCK_SIZ = (DEINT_SYNCD_DEPTH + 1) * DEINT_INTLV_SYNCDATA;
 static const uint16_t DEINT_SYNCD_BUF_STEP = (DEINT_SYNCD_DEPTH - 1) * DEINT_INTLV_SYNCDATA;
+static const uint8_t DEINT_SYNCD_WINDOW = 57; /* Sync offsets tested per 64-bit window */
+static const uint8_t DEINT_SYNCD_BITS_PAD = 4; /* Extra words at the end of hard bits buffer */
+
+static const uint8_t DEINT_SOFT_SYNC_WORDS = 16; /* Number of sync words to correlate */
+static const uint16_t DEINT_SOFT_SYNC_MARGIN =
+    DEINT_SOFT_SYNC_WORDS * DEINT_INTLV_SYNCDATA + DEINT_INTLV_SYNC_LEN;
+static const uint8_t DEINT_SOFT_SYNC_THRESH = 70; /* Default sync threshold (in percents) */
+static const uint8_t DEINT_SOFT_SYNC_THRESH_MIN = 50;
+static const uint8_t DEINT_SOFT_SYNC_THRESH_MAX = 100;
+static const uint8_t DEINT_SYNC_LOOKAHEAD = 128; /* Number of sync words to look ahead */
+
+/* De Bruijn sequence and its position table for finding the lowest set bit of 64-bit word */
+static const uint64_t DEINT_CTZ_DEBRUIJN = UINT64_C(0x03F79D71B4CB0A89);
+static const uint8_t DEINT_CTZ_TABLE[64] = { /* 2^6 */
+     0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+    62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+    63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+    46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+};
 
 /*************************************************************************************************/
 
-/** Make byte from QPSK data stream.
+/** Pack QPSK data stream into hard bits.
  *
- * Uses hard decision technique (thresholding) to produce an 8-bit byte for given QPSK data:
- * (only 8 consecutive QPSK bytes are used therefore \p data length should be at least 8).
- * Usually used to find a sync word for the resynchronizing function.
+ * Uses hard decision technique (thresholding) to convert every soft symbol byte of \p data into
+ * a single bit. Bits are stored little-endian: bit \c i of the stream is bit <tt>(i % 64)</tt>
+ * of the word <tt>(i / 64)</tt>.
  *
  * \param data Pointer to the QPSK data.
+ * \param len Length of QPSK data (in bytes).
+ * \param[out] bits Pointer to the zero-initialized storage for packed hard bits.
+ */
+static void pack_hard_bits(
+        const int8_t *data,
+        size_t len,
+        uint64_t *bits);
+
+/** Peek 64 consecutive hard bits from packed stream.
+ *
+ * \param bits Pointer to the packed hard bits.
+ * \param pos Position of the first bit to peek.
+ *
+ * \return 64 hard bits starting with bit \p pos (the first one is the LSB).
+ */
+static inline uint64_t peek_hard_bits(
+        const uint64_t *bits,
+        size_t pos);
+
+/** Find the lowest set bit of 64-bit word.
+ *
+ * Isolates the lowest set bit and maps it to its index through de Bruijn multiplication.
  *
- * \return Byte representation for given QPSK data.
+ * \param x Non-zero word.
+ *
+ * \return Index of the lowest set bit of \p x.
  */
-static uint8_t qpsk_to_byte(
-        const int8_t *data);
+static inline uint8_t lowest_set_bit(
+        uint64_t x);
 
 /** Find sync in the data stream.
  *
  * The sync word could be in any of 8 different orientations, so we will just look for a repeating
  * bit pattern the right distance apart to find the position of a sync word (8-bit byte, 00100111,
- * repeating every 80 symbols in stream).
+ * repeating every 80 symbols in stream). All candidate offsets are tested at once by XOR-ing
+ * 64-bit windows of hard bits which are one sync period apart.
  *
- * \param data Pointer to the data stream to find sync in.
+ * \param bits Pointer to the packed hard bits of data stream to find sync in.
+ * \param pos Position in the stream to start search from.
  * \param[out] offset Pointer to the final offset value. Contains valid value only if search
  * was successfull.
  * \param[out] sync Pointer to the final value of sync byte.
@@ -86,10 +131,50 @@ static uint8_t qpsk_to_byte(
  * \return \c true if sync was found and false otherwise.
  */
 static bool find_sync(
+        const uint64_t *bits,
+        size_t pos,
+        uint8_t *offset,
+        uint8_t *sync);
+
+/** Find sync in the data stream by soft correlation.
+ *
+ * Used when exact search with find_sync() fails. For every candidate offset soft symbols of
+ * #DEINT_SOFT_SYNC_WORDS sync positions are summed bit by bit: sync bits add up coherently while
+ * data bits tend to cancel out, so a few bit errors in sync words don't break detection.
+ * Offset with the best agreement is taken if it passes the threshold.
+ *
+ * \param data Pointer to the QPSK data, should have at least #DEINT_SOFT_SYNC_MARGIN bytes.
+ * \param thresh Minimum agreement (in percents).
+ * \param[out] offset Pointer to the final offset value. Contains valid value only if search
+ * was successfull.
+ * \param[out] sync Pointer to the final value of sync byte (hard decision of summed bits).
+ *
+ * \return \c true if sync was found and false otherwise.
+ */
+static bool find_sync_soft(
         const int8_t *data,
+        uint8_t thresh,
         uint8_t *offset,
         uint8_t *sync);
 
+/** Check whether soft symbols agree with the sync byte.
+ *
+ * Correlates \p n sync words one sync period apart with the \p sync pattern. Sync words made of
+ * zero soft symbols only agree with all-ones sync byte, as they do for hard decision.
+ *
+ * \param data Pointer to the QPSK data at the first sync word.
+ * \param sync Sync byte.
+ * \param n Number of sync words to correlate.
+ * \param thresh Minimum agreement (in percents).
+ *
+ * \return \c true if agreement is not less than \p thresh and \c false otherwise.
+ */
+static bool sync_agrees(
+        const int8_t *data,
+        uint8_t sync,
+        uint16_t n,
+        uint8_t thresh);
+
 /** Perform stream resyncing.
  *
  * Interleaved QPSK symbols stream with 80 kSym/s rate contains the following pattern:
@@ -97,153 +182,343 @@ static bool find_sync(
  * Before passing QPSK data to the decoder the sync words must be removed and the stream
  * should be stitched back together.
  *
+ * Resyncing is a small state machine. While searching, sync is acquired with find_sync() and,
+ * if that fails, with find_sync_soft(). While locked, sync word of each block is checked against
+ * acquired sync byte; if it doesn't agree the lock is kept only if soft sync trains ahead at the
+ * same phase still agree, so short fades don't drop whole blocks from the stream.
+ *
+ * \param deintlv Pointer to the deinterleaver object.
  * \param[in,out] data Pointer to the QPSK data storage.
  *
  * \return \c true on successfull resyncing and \c false otherwise.
  */
 static bool resync_stream(
+        const lrpt_dsp_deinterleaver_t *deintlv,
         lrpt_qpsk_data_t *data);
 
+/** Perform convolutional deinterleaving.
+ *
+ * Input stream is treated as a matrix with #DEINT_INTLV_BRANCHES columns (one per interleaver
+ * branch). Each branch is just a column shifted by a constant offset, so the data is processed
+ * in tiles of #DEINT_INTLV_TILE_ROWS rows and every branch is copied with a plain strided loop
+ * inside the tile. This keeps both reads and writes local instead of jumping over the whole
+ * output buffer for each consecutive symbol.
+ *
+ * \param input Pointer to the resynchronized QPSK data.
+ * \param[out] output Pointer to the zero-initialized resulting buffer.
+ * \param len Length of both \p input and \p output (in bytes).
+ */
+static void deinterleave(
+        const int8_t *input,
+        int8_t *output,
+        size_t len);
+
 /*************************************************************************************************/
 
-/* qpsk_to_byte() */
-static uint8_t qpsk_to_byte(
-        const int8_t *data) {
-    uint8_t b = 0;
+/* pack_hard_bits() */
+static void pack_hard_bits(
+        const int8_t *data,
+        size_t len,
+        uint64_t *bits) {
+    const size_t full_words = len / 64;
 
-    /* Assume little-endian conversion */
-    for (uint8_t i = 0; i < 8; i++) {
-        uint8_t bit = (data[i] < 0) ? 0 : 1;
+    for (size_t i = 0; i < full_words; i++) {
+        const int8_t *p = (data + i * 64);
+        uint64_t w = 0;
 
-        b |= (bit << i);
+        for (uint8_t j = 0; j < 64; j++)
+            w |= ((uint64_t)(p[j] >= 0) << j);
+
+        bits[i] = w;
     }
 
-    return b;
+    for (size_t i = (full_words * 64); i < len; i++)
+        bits[i / 64] |= ((uint64_t)(data[i] >= 0) << (i % 64));
+}
+
+/*************************************************************************************************/
+
+/* peek_hard_bits() */
+static inline uint64_t peek_hard_bits(
+        const uint64_t *bits,
+        size_t pos) {
+    const size_t idx = (pos / 64);
+    const uint8_t shift = (pos % 64);
+
+    if (shift == 0)
+        return bits[idx];
+    else
+        return ((bits[idx] >> shift) | (bits[idx + 1] << (64 - shift)));
+}
+
+/*************************************************************************************************/
+
+/* lowest_set_bit() */
+static inline uint8_t lowest_set_bit(
+        uint64_t x) {
+    return DEINT_CTZ_TABLE[((x & (~x + 1)) * DEINT_CTZ_DEBRUIJN) >> 58];
 }
 
 /*************************************************************************************************/
 
 /* find_sync() */
 static bool find_sync(
-        const int8_t *data,
+        const uint64_t *bits,
+        size_t pos,
         uint8_t *offset,
         uint8_t *sync) {
+    /* Search for a sync byte at the beginning of block */
+    for (uint8_t base = 0; base < DEINT_INTLV_SYNCDATA; base += DEINT_SYNCD_WINDOW) {
+        const uint64_t first = peek_hard_bits(bits, pos + base);
+        uint64_t diff = 0;
+
+        /* Compare against DEINT_SYNCD_DEPTH windows at intervals of (sync + data = 80 syms) */
+        for (uint8_t j = 1; j <= DEINT_SYNCD_DEPTH; j++)
+            diff |= (first ^ peek_hard_bits(bits, pos + base + j * DEINT_INTLV_SYNCDATA));
+
+        /* Bit i is set only if 8 bits starting with i have no mismatches */
+        uint64_t match = ~diff;
+
+        match &= (match >> 1);
+        match &= (match >> 2);
+        match &= (match >> 4);
+
+        /* Drop candidates beyond the sync period */
+        if ((base + DEINT_SYNCD_WINDOW) > DEINT_INTLV_SYNCDATA)
+            match &= ((UINT64_C(1) << (DEINT_INTLV_SYNCDATA - base)) - 1);
+
+        /* Record the first unbroken series of matching sync byte candidates */
+        if (match != 0) {
+            const uint8_t i = lowest_set_bit(match);
+
+            *offset = (base + i);
+            *sync = ((first >> i) & 0xFF);
+
+            return true;
+        }
+    }
+
     *offset = 0;
-    bool result = false;
 
-    /* Search for a sync byte at the beginning of block */
-    for (
-            uint8_t i = 0;
-            i < (DEINT_SYNCD_BLOCK_SIZ - DEINT_INTLV_SYNCDATA * DEINT_SYNCD_DEPTH);
-            i++) {
-        result = true;
+    return false;
+}
 
-        /* Assemble a sync byte candidate */
-        *sync = qpsk_to_byte(data + i);
+/*************************************************************************************************/
 
-        /* Search ahead DEINT_SYNCD_DEPTH times in buffer to see if there are exactly equal sync
-         * byte candidates at intervals of (sync + data = 80 syms) blocks
-         */
-        for (uint8_t j = 1; j <= DEINT_SYNCD_DEPTH; j++) {
-            /* Break if there is a mismatch at any position */
-            uint8_t test = qpsk_to_byte(data + i + j * DEINT_INTLV_SYNCDATA);
+/* find_sync_soft() */
+static bool find_sync_soft(
+        const int8_t *data,
+        uint8_t thresh,
+        uint8_t *offset,
+        uint8_t *sync) {
+    /* Ring buffers of per-bit sums and magnitudes for the current 8-bit window */
+    int32_t sums[8];
+    int32_t mags[8];
 
-            if (*sync != test) {
-                result = false;
+    int32_t agree = 0;
+    int32_t energy = 0;
 
-                break;
-            }
+    int64_t best_agree = -1;
+    int64_t best_energy = 1;
+    uint8_t best_offset = 0;
+
+    for (uint8_t x = 0; x < (DEINT_INTLV_SYNCDATA + DEINT_INTLV_SYNC_LEN - 1); x++) {
+        int32_t sum = 0;
+        int32_t mag = 0;
+
+        for (uint8_t k = 0; k < DEINT_SOFT_SYNC_WORDS; k++) {
+            const int8_t v = data[x + k * DEINT_INTLV_SYNCDATA];
+
+            sum += v;
+            mag += abs(v);
         }
 
-        /* If an unbroken series of matching sync byte candidates located, record the buffer
-         * offset and return the result
-         */
-        if (result) {
-            *offset = i;
+        const uint8_t slot = (x % DEINT_INTLV_SYNC_LEN);
 
-            break;
+        /* Slide window forward */
+        if (x >= DEINT_INTLV_SYNC_LEN) {
+            agree -= abs(sums[slot]);
+            energy -= mags[slot];
+        }
+
+        sums[slot] = sum;
+        mags[slot] = mag;
+        agree += abs(sum);
+        energy += mag;
+
+        if (x < (DEINT_INTLV_SYNC_LEN - 1))
+            continue;
+
+        /* Compare agree / energy ratios without division */
+        if ((energy > 0) && ((agree * best_energy) > (best_agree * energy))) {
+            best_agree = agree;
+            best_energy = energy;
+            best_offset = (x - DEINT_INTLV_SYNC_LEN + 1);
         }
     }
 
-    return result;
+    if ((best_agree < 0) || ((100 * best_agree) < ((int64_t)thresh * best_energy)))
+        return false;
+
+    /* Make sync byte from the summed soft symbols */
+    uint8_t b = 0;
+
+    for (uint8_t i = 0; i < DEINT_INTLV_SYNC_LEN; i++) {
+        int32_t sum = 0;
+
+        for (uint8_t k = 0; k < DEINT_SOFT_SYNC_WORDS; k++)
+            sum += data[best_offset + i + k * DEINT_INTLV_SYNCDATA];
+
+        b |= ((sum < 0) ? 0 : 1) << i;
+    }
+
+    *offset = best_offset;
+    *sync = b;
+
+    return true;
+}
+
+/*************************************************************************************************/
+
+/* sync_agrees() */
+static bool sync_agrees(
+        const int8_t *data,
+        uint8_t sync,
+        uint16_t n,
+        uint8_t thresh) {
+    int32_t agree = 0;
+    int32_t energy = 0;
+
+    for (uint16_t k = 0; k < n; k++) {
+        const int8_t *p = (data + k * DEINT_INTLV_SYNCDATA);
+
+        for (uint8_t i = 0; i < DEINT_INTLV_SYNC_LEN; i++) {
+            /* Sync bit set means non-negative soft symbol */
+            agree += ((sync >> i) & 0x01) ? p[i] : -p[i];
+            energy += abs(p[i]);
+        }
+    }
+
+    /* Zero soft symbols carry no information but they are hard ones for find_sync(), so treat
+     * zero-energy sync words the same way exact search does
+     */
+    if (energy == 0)
+        return (sync == 0xFF);
+
+    return ((100 * agree) >= (thresh * energy));
 }
 
 /*************************************************************************************************/
 
 /* resync_stream() */
 static bool resync_stream(
+        const lrpt_dsp_deinterleaver_t *deintlv,
         lrpt_qpsk_data_t *data) {
     if (((2 * data->len) < DEINT_SYNCD_BUF_MARGIN) || ((2 * data->len) < DEINT_INTLV_SYNCDATA))
         return false;
 
-    /* Allocate temporary buffer for resyncing */
-    int8_t *tmp_buf = calloc(2 * data->len, sizeof(int8_t));
+    /* Convert whole stream to the hard bits once. Sync search looks a bit past the end of data
+     * so the buffer is padded with zeroes
+     */
+    uint64_t *bits = calloc((2 * data->len) / 64 + DEINT_SYNCD_BITS_PAD, sizeof(uint64_t));
 
-    if (!tmp_buf)
+    if (!bits)
         return false;
 
-    /* Do a copy of the original data */
-    memcpy(tmp_buf, data->qpsk, sizeof(int8_t) * 2 * data->len);
+    pack_hard_bits(data->qpsk, 2 * data->len, bits);
+
+    const uint8_t thresh = deintlv->sync_thresh;
 
     size_t resync_size = 0;
     size_t posn = 0;
     uint8_t offset = 0;
+    uint8_t sync = 0;
+    bool locked = false;
+    bool fresh = false; /* Lock was just acquired and no block was copied yet */
     size_t limit1 = 2 * data->len - DEINT_SYNCD_BUF_MARGIN;
     size_t limit2 = 2 * data->len - DEINT_INTLV_SYNCDATA;
 
-    /* Do while there is a room in the raw buffer for the find_sync() to search for
-     * sync candidates
-     */
-    while (posn < limit1) {
-        uint8_t sync;
+    while (true) {
+        if (!locked) {
+            /* Stop if there is no room in the raw buffer for the find_sync() to search for
+             * sync candidates
+             */
+            if (posn >= limit1)
+                break;
 
-        /* Only search for sync if look-forward below fails to find a sync train */
-        if (!find_sync(tmp_buf + posn, &offset, &sync)) {
-            posn += DEINT_SYNCD_BUF_STEP;
+            /* Try exact search first and fall back to soft one if there is enough data */
+            if (find_sync(bits, posn, &offset, &sync))
+                locked = true;
+            else if ((posn + DEINT_SOFT_SYNC_MARGIN) <= (2 * data->len))
+                locked = find_sync_soft(data->qpsk + posn, thresh, &offset, &sync);
+
+            if (locked) {
+                posn += offset;
+                fresh = true;
+            }
+            else
+                posn += DEINT_SYNCD_BUF_STEP;
 
             continue;
         }
 
-        posn += offset;
+        /* Stop if there is no room in the raw buffer to look forward for sync trains */
+        if (posn >= limit2)
+            break;
 
-        /* Do while there is a room in the raw buffer to look forward for sync trains */
-        while (posn < limit2) {
-            /* Look ahead to prevent it losing sync on a weak signal */
+        /* Look ahead to prevent it losing sync on a weak signal */
+        if (!sync_agrees(data->qpsk + posn, sync, 1, thresh)) {
             bool ok = false;
 
-            for (uint8_t i = 0; i < 128; i++) {
+            for (uint8_t i = 0; i < DEINT_SYNC_LOOKAHEAD; i += DEINT_SOFT_SYNC_WORDS) {
                 size_t tmp = posn + i * DEINT_INTLV_SYNCDATA;
 
-                if (tmp < limit2) {
-                    uint8_t test = qpsk_to_byte(tmp_buf + tmp);
+                if (tmp >= limit2)
+                    break;
+
+                /* Number of sync words left in the buffer */
+                uint16_t n = ((limit2 - tmp - 1) / DEINT_INTLV_SYNCDATA + 1);
 
-                    if (sync == test) {
-                        ok = true;
+                if (n > DEINT_SOFT_SYNC_WORDS)
+                    n = DEINT_SOFT_SYNC_WORDS;
 
-                        break;
-                    }
+                if (sync_agrees(data->qpsk + tmp, sync, n, thresh)) {
+                    ok = true;
+
+                    break;
                 }
             }
 
-            if (!ok)
-                break;
-
-            /* Copy the actual data after the sync train (8 bits) and update total number of
-             * copied symbols
+            /* Sync is lost, search for it again. If the lock has failed its very first check
+             * skip the whole sync period, otherwise the search would lock at the same place
              */
-            memcpy(
-                    data->qpsk + resync_size,
-                    tmp_buf + posn + 8,
-                    sizeof(int8_t) * DEINT_INTLV_DATA_LEN);
-            resync_size += DEINT_INTLV_DATA_LEN;
-
-            /* Move on to the next sync train position */
-            posn += DEINT_INTLV_SYNCDATA;
+            if (!ok) {
+                if (fresh)
+                    posn += DEINT_INTLV_SYNCDATA;
+
+                locked = false;
+
+                continue;
+            }
         }
+
+        /* Copy the actual data after the sync train (8 bits) and update total number of
+         * copied symbols. Resynced data is always behind the current position so it's safe
+         * to move it in place
+         */
+        memmove(
+                data->qpsk + resync_size,
+                data->qpsk + posn + 8,
+                sizeof(int8_t) * DEINT_INTLV_DATA_LEN);
+        resync_size += DEINT_INTLV_DATA_LEN;
+        fresh = false;
+
+        /* Move on to the next sync train position */
+        posn += DEINT_INTLV_SYNCDATA;
     }
 
-    /* Free temporary buffer */
-    free(tmp_buf);
+    /* Free hard bits buffer */
+    free(bits);
 
     if (!lrpt_qpsk_data_resize(data, resync_size / 2, NULL))
         return false;
@@ -253,6 +528,51 @@ static bool resync_stream(
 
 /*************************************************************************************************/
 
+/* deinterleave() */
+static void deinterleave(
+        const int8_t *input,
+        int8_t *output,
+        size_t len) {
+    const int64_t n = len;
+    const size_t rows = (len + DEINT_INTLV_BRANCHES - 1) / DEINT_INTLV_BRANCHES;
+
+    for (size_t tile = 0; tile < rows; tile += DEINT_INTLV_TILE_ROWS) {
+        const size_t tile_end =
+            ((tile + DEINT_INTLV_TILE_ROWS) < rows) ? (tile + DEINT_INTLV_TILE_ROWS) : rows;
+
+        for (uint8_t b = 0; b < DEINT_INTLV_BRANCHES; b++) {
+            /* Offset by half a message to include leading and trailing fuzz */
+            const int64_t offset =
+                (int64_t)(DEINT_INTLV_BRANCHES - 1) * DEINT_INTLV_DELAY -
+                (int64_t)b * DEINT_INTLV_BASE_LEN +
+                (int64_t)(DEINT_INTLV_BRANCHES / 2) * DEINT_INTLV_BASE_LEN;
+
+            /* Find the range of rows which land inside both buffers for this branch */
+            const int64_t lo = (-offset - b);
+            const int64_t hi_dst = (n - offset - b);
+            const int64_t hi_src = (n - b);
+            const int64_t hi = (hi_dst < hi_src) ? hi_dst : hi_src;
+
+            size_t first = (lo <= 0) ? 0 : ((lo + DEINT_INTLV_BRANCHES - 1) / DEINT_INTLV_BRANCHES);
+            size_t last = (hi <= 0) ? 0 : ((hi + DEINT_INTLV_BRANCHES - 1) / DEINT_INTLV_BRANCHES);
+
+            if (first < tile)
+                first = tile;
+
+            if (last > tile_end)
+                last = tile_end;
+
+            for (size_t k = first; k < last; k++) {
+                const size_t i = (k * DEINT_INTLV_BRANCHES + b);
+
+                output[i + offset] = input[i];
+            }
+        }
+    }
+}
+
+/*************************************************************************************************/
+
 /* lrpt_dsp_deinterleaver_init() */
 lrpt_dsp_deinterleaver_t *lrpt_dsp_deinterleaver_init(
         lrpt_error_t *err) {
@@ -267,6 +587,8 @@ lrpt_dsp_deinterleaver_t *lrpt_dsp_deinterleaver_init(
         return NULL;
     }
 
+    deintlv->sync_thresh = DEINT_SOFT_SYNC_THRESH;
+
     if (err)
         lrpt_error_set(err, LRPT_ERR_LVL_NONE, LRPT_ERR_CODE_NONE, NULL);
 
@@ -283,15 +605,46 @@ void lrpt_dsp_deinterleaver_deinit(
 
 /*************************************************************************************************/
 
+/* lrpt_dsp_deinterleaver_set_sync_thresh() */
+bool lrpt_dsp_deinterleaver_set_sync_thresh(
+        lrpt_dsp_deinterleaver_t *deintlv,
+        uint8_t thresh,
+        lrpt_error_t *err) {
+    if (!deintlv) {
+        if (err)
+            lrpt_error_set(err, LRPT_ERR_LVL_ERROR, LRPT_ERR_CODE_INVOBJ,
+                    "Deinterleaver object is NULL");
+
+        return false;
+    }
+
+    if ((thresh < DEINT_SOFT_SYNC_THRESH_MIN) || (thresh > DEINT_SOFT_SYNC_THRESH_MAX)) {
+        if (err)
+            lrpt_error_set(err, LRPT_ERR_LVL_ERROR, LRPT_ERR_CODE_PARAM,
+                    "Sync threshold is out of range");
+
+        return false;
+    }
+
+    deintlv->sync_thresh = thresh;
+
+    if (err)
+        lrpt_error_set(err, LRPT_ERR_LVL_NONE, LRPT_ERR_CODE_NONE, NULL);
+
+    return true;
+}
+
+/*************************************************************************************************/
+
 /* lrpt_dsp_deinterleaver_exec() */
 bool lrpt_dsp_deinterleaver_exec(
         lrpt_dsp_deinterleaver_t *deintlv,
         lrpt_qpsk_data_t *data,
         lrpt_error_t *err) {
-    if (!data) {
+    if (!deintlv || !data) {
         if (err)
             lrpt_error_set(err, LRPT_ERR_LVL_ERROR, LRPT_ERR_CODE_INVOBJ,
-                    "QPSK data object is NULL");
+                    "Deinterleaver object and/or QPSK data object are NULL");
 
         return false;
     }
@@ -302,7 +655,7 @@ bool lrpt_dsp_deinterleaver_exec(
     /* Resynchronize raw data at the bottom of the raw buffer after the
      * DEINT_INTLV_BRANCHES * DEINT_INTLV_BASE_LEN and up to the end
      */
-    if (!resync_stream(data)) {
+    if (!resync_stream(deintlv, data)) {
         if (err)
             lrpt_error_set(err, LRPT_ERR_LVL_ERROR, LRPT_ERR_CODE_DATAPROC,
                     "Can't resynchronize QPSK data stream");
@@ -332,17 +685,7 @@ bool lrpt_dsp_deinterleaver_exec(
 
     /* Perform convolutional deinterleaving */
     /* https://en.wikipedia.org/wiki/Burst_error-correcting_code#Convolutional_interleaver */
-    for (size_t i = 0; i < (2 * data->len); i++) {
-        /* Offset by half a message to include leading and trailing fuzz */
-        int64_t pos =
-            i +
-            (DEINT_INTLV_BRANCHES - 1) * DEINT_INTLV_DELAY -
-            (i % DEINT_INTLV_BRANCHES) * DEINT_INTLV_BASE_LEN +
-            (DEINT_INTLV_BRANCHES / 2) * DEINT_INTLV_BASE_LEN;
-
-        if ((pos >= 0) && (pos < (2 * data->len)))
-            res_buf[pos] = data->qpsk[i];
-    }
+    deinterleave(data->qpsk, res_buf, 2 * data->len);
 
     /* Reassign pointers */
     free(data->qpsk);
@@ -31,10 +31,13 @@
 
 /*************************************************************************************************/
 
+#include <stdint.h>
+
+/*************************************************************************************************/
+
 /** Deinterleaver object */
 struct lrpt_dsp_deinterleaver__ {
-    /** Empty structs in C11 leads to UB so we'll keep pointer to the \c void here*/
-    void *stub;
+    uint8_t sync_thresh; /**< Minimum soft agreement between sync words (in percents) */
 };
 
 /*************************************************************************************************/
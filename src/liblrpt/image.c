@@ -85,6 +85,7 @@ lrpt_image_t *lrpt_image_alloc(
 
     image->width = width;
     image->height = height;
+    image->sparse = false;
 
     if (err)
         lrpt_error_set(err, LRPT_ERR_LVL_NONE, LRPT_ERR_CODE_NONE, NULL);
@@ -94,6 +95,56 @@ lrpt_image_t *lrpt_image_alloc(
 
 /*************************************************************************************************/
 
+/* lrpt_image_alloc_sparse() */
+lrpt_image_t *lrpt_image_alloc_sparse(
+        size_t width,
+        size_t height,
+        lrpt_error_t *err) {
+    lrpt_image_t *image = lrpt_image_alloc(0, 0, err);
+
+    if (!image)
+        return NULL;
+
+    image->width = width;
+    image->height = height;
+    image->sparse = true;
+
+    return image;
+}
+
+/*************************************************************************************************/
+
+/* lrpt_image_add_channel() */
+bool lrpt_image_add_channel(
+        lrpt_image_t *image,
+        uint8_t apid,
+        lrpt_error_t *err) {
+    if (!image || (apid < 64) || (apid > 69)) {
+        if (err)
+            lrpt_error_set(err, LRPT_ERR_LVL_ERROR, LRPT_ERR_CODE_PARAM,
+                    "LRPT image object is NULL or APID is incorrect");
+
+        return false;
+    }
+
+    if (image->channels[apid - 64] || ((image->width * image->height) == 0))
+        return true;
+
+    image->channels[apid - 64] = calloc(image->width * image->height, sizeof(uint8_t));
+
+    if (!image->channels[apid - 64]) {
+        if (err)
+            lrpt_error_set(err, LRPT_ERR_LVL_ERROR, LRPT_ERR_CODE_ALLOC,
+                    "Pixel buffer allocation for LRPT image object has failed");
+
+        return false;
+    }
+
+    return true;
+}
+
+/*************************************************************************************************/
+
 /* lrpt_image_free() */
 inline void lrpt_image_free(
         lrpt_image_t *image) {
@@ -138,7 +189,7 @@ bool lrpt_image_set_width(
     /* Check only image already have a width */
     bool good = true;
 
-    if (image && (image->width > 0)) {
+    if (image && !image->sparse && (image->width > 0)) {
         for (uint8_t i = 0; i < 6; i++)
             if (!image->channels[i]) {
                 good = false;
@@ -177,6 +228,13 @@ bool lrpt_image_set_width(
         uint8_t *new_bufs[6];
 
         for (uint8_t i = 0; i < 6; i++) {
+            /* Absent channels of sparse image stay absent */
+            if (image->sparse && !image->channels[i]) {
+                new_bufs[i] = NULL;
+
+                continue;
+            }
+
             new_bufs[i] =
                 reallocarray(image->channels[i], image->height * new_width, sizeof(uint8_t));
 
@@ -197,7 +255,7 @@ bool lrpt_image_set_width(
         else {
             for (uint8_t i = 0; i < 6; i++) {
                 /* Zero out newly allocated parts of pixel buffers */
-                if (new_width > image->width)
+                if (new_bufs[i] && (new_width > image->width))
                     memset(
                             new_bufs[i] + image->height * image->width,
                             0,
@@ -226,7 +284,7 @@ bool lrpt_image_set_height(
     /* Check only image already have a height */
     bool good = true;
 
-    if (image && (image->height > 0)) {
+    if (image && !image->sparse && (image->height > 0)) {
         for (uint8_t i = 0; i < 6; i++)
             if (!image->channels[i]) {
                 good = false;
@@ -265,6 +323,13 @@ bool lrpt_image_set_height(
         uint8_t *new_bufs[6];
 
         for (uint8_t i = 0; i < 6; i++) {
+            /* Absent channels of sparse image stay absent */
+            if (image->sparse && !image->channels[i]) {
+                new_bufs[i] = NULL;
+
+                continue;
+            }
+
             new_bufs[i] =
                 reallocarray(image->channels[i], image->width * new_height, sizeof(uint8_t));
 
@@ -285,7 +350,7 @@ bool lrpt_image_set_height(
         else {
             for (uint8_t i = 0; i < 6; i++) {
                 /* Zero out newly allocated parts of pixel buffers */
-                if (new_height > image->height)
+                if (new_bufs[i] && (new_height > image->height))
                     memset(
                             new_bufs[i] + image->height * image->width,
                             0,
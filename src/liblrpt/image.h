@@ -31,6 +31,9 @@
 
 /*************************************************************************************************/
 
+#include "../../include/lrpt.h"
+
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -42,10 +45,45 @@ struct lrpt_image__ {
     size_t height; /**< Height of the image (in px) */
 
     uint8_t *channels[6]; /**< Per-channel image arrays */
+
+    bool sparse; /**< Whether channels are allocated on demand (absent ones are \c NULL) */
 };
 
 /*************************************************************************************************/
 
+/** Allocate sparse LRPT image object.
+ *
+ * Channels aren't allocated until #lrpt_image_add_channel() is called for them. Resizing
+ * affects present channels only.
+ *
+ * \param width Width of the image in number of pixels.
+ * \param height Height of the image in number of pixels.
+ * \param err Pointer to the error object (set to \c NULL if no error reporting is needed).
+ *
+ * \return Pointer to the allocated LRPT image object or \c NULL in case of error.
+ */
+lrpt_image_t *lrpt_image_alloc_sparse(
+        size_t width,
+        size_t height,
+        lrpt_error_t *err);
+
+/** Allocate channel of sparse LRPT image object.
+ *
+ * Channel is zero-filled. Nothing is done if channel is already present.
+ *
+ * \param image Pointer to the LRPT image object.
+ * \param apid APID number (must be within 64-69 range).
+ * \param err Pointer to the error object (set to \c NULL if no error reporting is needed).
+ *
+ * \return \c true on successfull allocation or \c false in case of error.
+ */
+bool lrpt_image_add_channel(
+        lrpt_image_t *image,
+        uint8_t apid,
+        lrpt_error_t *err);
+
+/*************************************************************************************************/
+
 #endif
 
 /*************************************************************************************************/
@@ -0,0 +1,326 @@
+/*
+ * This file is part of liblrpt.
+ *
+ * liblrpt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liblrpt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liblrpt. If not, see https://www.gnu.org/licenses/
+ *
+ * Author: Viktor Drobot
+ */
+
+/*************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <check.h>
+
+#include "decoder/bitop.h"
+
+/*************************************************************************************************/
+
+static int TEST_rounds = 2000;
+static size_t TEST_max_bits = 4096; /* Bits written per round */
+static size_t TEST_max_len = 24; /* Reader buffer length (in bytes) */
+
+/*************************************************************************************************/
+
+/* Reference bit access, MSB of the first byte is the first bit */
+static uint8_t ref_bit(const uint8_t *p, size_t len, size_t i) {
+    if ((i / 8) >= len)
+        return 0;
+
+    return ((p[i / 8] >> (7 - i % 8)) & 0x01);
+}
+
+static void ref_set_bit(uint8_t *p, size_t i, uint8_t bit) {
+    if (bit)
+        p[i / 8] |= (0x80 >> (i % 8));
+}
+
+static uint64_t rand64(void) {
+    uint64_t x = 0;
+
+    for (uint8_t i = 0; i < 8; i++)
+        x = ((x << 8) | (rand() & 0xFF));
+
+    return x;
+}
+
+/*************************************************************************************************/
+
+START_TEST(test_count) {
+    ck_assert_int_eq(lrpt_decoder_bitop_count(0), 0);
+    ck_assert_int_eq(lrpt_decoder_bitop_count(UINT32_MAX), 32);
+    ck_assert_int_eq(lrpt_decoder_bitop_count(0x1ACFFC1D), 19);
+}
+
+START_TEST(test_write_aligned) {
+    uint8_t bytes[24] = { 0 };
+    lrpt_decoder_bitop_t w;
+
+    /* Full words while there are no pending bits */
+    lrpt_decoder_bitop_writer_set(&w, bytes);
+    lrpt_decoder_bitop_write_n_bits(&w, UINT64_C(0x0123456789ABCDEF), 64);
+    lrpt_decoder_bitop_write_n_bits(&w, UINT64_C(0xFEDCBA9876543210), 64);
+    lrpt_decoder_bitop_write_n_bits(&w, 0x0B, 4); /* tail of incomplete byte is dropped */
+    lrpt_decoder_bitop_writer_flush(&w);
+
+    ck_assert_int_eq(w.pos, 16);
+    ck_assert_int_eq(w.cur_len, 4);
+
+    for (uint8_t i = 0; i < 8; i++) {
+        ck_assert_int_eq(bytes[i], ((UINT64_C(0x0123456789ABCDEF) >> (56 - 8 * i)) & 0xFF));
+        ck_assert_int_eq(bytes[8 + i], ((UINT64_C(0xFEDCBA9876543210) >> (56 - 8 * i)) & 0xFF));
+    }
+
+    ck_assert_int_eq(bytes[16], 0);
+}
+
+START_TEST(test_write_random) {
+    uint8_t *bytes = calloc(TEST_max_bits / 8 + 16, sizeof(uint8_t));
+    uint8_t *ref = calloc(TEST_max_bits / 8 + 16, sizeof(uint8_t));
+
+    ck_assert_ptr_nonnull(bytes);
+    ck_assert_ptr_nonnull(ref);
+
+    srand(1);
+
+    for (int r = 0; r < TEST_rounds; r++) {
+        lrpt_decoder_bitop_t w;
+        size_t total = 0;
+
+        memset(bytes, 0, TEST_max_bits / 8 + 16);
+        memset(ref, 0, TEST_max_bits / 8 + 16);
+        lrpt_decoder_bitop_writer_set(&w, bytes);
+
+        while (total < (TEST_max_bits - 256)) {
+            if ((rand() % 8) == 0) {
+                /* Packed words, MSB first */
+                uint64_t words[3] = { rand64(), rand64(), rand64() };
+                size_t n = (rand() % 193);
+
+                lrpt_decoder_bitop_write_words(&w, words, n);
+
+                for (size_t i = 0; i < n; i++)
+                    ref_set_bit(ref, total + i, ((words[i / 64] >> (63 - i % 64)) & 0x01));
+
+                total += n;
+            }
+            else {
+                /* Any number of bits, including full words at any pending length; bits above
+                 * n should be ignored
+                 */
+                uint64_t bits = rand64();
+                uint8_t n = ((rand() % 4) == 0) ? 64 : (rand() % 65);
+
+                lrpt_decoder_bitop_write_n_bits(&w, bits, n);
+
+                for (uint8_t i = 0; i < n; i++)
+                    ref_set_bit(ref, total + i, ((bits >> (n - 1 - i)) & 0x01));
+
+                total += n;
+            }
+        }
+
+        lrpt_decoder_bitop_writer_flush(&w);
+
+        /* Whole bytes are stored, trailing bits stay pending */
+        ck_assert_int_eq(w.pos, total / 8);
+        ck_assert_int_eq(w.cur_len, total % 8);
+        ck_assert_mem_eq(bytes, ref, total / 8);
+    }
+
+    free(bytes);
+    free(ref);
+}
+
+START_TEST(test_read_random) {
+    uint8_t bytes[24]; /* TEST_max_len */
+
+    srand(2);
+
+    for (int r = 0; r < TEST_rounds; r++) {
+        const size_t len = (rand() % (TEST_max_len + 1));
+
+        for (size_t i = 0; i < TEST_max_len; i++)
+            bytes[i] = rand();
+
+        lrpt_decoder_bitop_t b;
+
+        lrpt_decoder_bitop_reader_set(&b, bytes, len);
+
+        /* Walk through the whole buffer and a bit past its end, which reads as zeroes */
+        while (b.pos <= (8 * len + 40)) {
+            const uint8_t n = (rand() % 33);
+            uint32_t ref_val = 0;
+
+            for (uint8_t i = 0; i < n; i++)
+                ref_val = ((ref_val << 1) | ref_bit(bytes, len, b.pos + i));
+
+            const size_t pos = b.pos;
+
+            ck_assert_uint_eq(lrpt_decoder_bitop_peek_n_bits(&b, n), ref_val);
+            ck_assert_int_eq(b.pos, pos);
+
+            if ((rand() % 2) == 0)
+                ck_assert_uint_eq(lrpt_decoder_bitop_pop_n_bits(&b, n), ref_val);
+            else
+                lrpt_decoder_bitop_advance_n_bits(&b, n);
+
+            ck_assert_int_eq(b.pos, pos + n);
+
+            /* Avoid being stuck with zero-length reads */
+            if (n == 0)
+                lrpt_decoder_bitop_advance_n_bits(&b, 1);
+        }
+    }
+}
+
+START_TEST(test_buf_read_random) {
+    uint8_t bytes[24]; /* TEST_max_len */
+
+    srand(4);
+
+    for (int r = 0; r < TEST_rounds; r++) {
+        const size_t len = (rand() % (TEST_max_len + 1));
+
+        for (size_t i = 0; i < TEST_max_len; i++)
+            bytes[i] = rand();
+
+        lrpt_decoder_bitop_t b;
+        size_t pos = 0; /* Bits consumed by reads */
+
+        lrpt_decoder_bitop_reader_set(&b, bytes, len);
+
+        /* Same walk as for plain reader, with refill before every batch of reads */
+        while (pos <= (8 * len + 40)) {
+            uint8_t left = 57;
+
+            lrpt_decoder_bitop_buf_refill(&b);
+            ck_assert_int_ge(b.cur_len, 57);
+            ck_assert_int_eq(b.pos - b.cur_len, pos);
+
+            while (left > 0) {
+                const uint8_t n = (1 + rand() % ((left < 32) ? left : 32));
+                uint32_t ref_val = 0;
+
+                for (uint8_t i = 0; i < n; i++)
+                    ref_val = ((ref_val << 1) | ref_bit(bytes, len, pos + i));
+
+                ck_assert_uint_eq(lrpt_decoder_bitop_buf_peek_n_bits(&b, n), ref_val);
+
+                if ((rand() % 2) == 0)
+                    ck_assert_uint_eq(lrpt_decoder_bitop_buf_pop_n_bits(&b, n), ref_val);
+                else
+                    lrpt_decoder_bitop_buf_advance_n_bits(&b, n);
+
+                pos += n;
+                left -= n;
+            }
+        }
+    }
+}
+
+START_TEST(test_roundtrip) {
+    const size_t n_bits = 1021;
+    uint8_t bytes[136] = { 0 }; /* n_bits / 8 + 8 */
+    uint32_t vals[1021];
+    uint8_t lens[1021];
+    size_t n = 0;
+    size_t total = 0;
+    lrpt_decoder_bitop_t b;
+
+    srand(3);
+    lrpt_decoder_bitop_writer_set(&b, bytes);
+
+    /* Values written with random widths are read back with the same widths */
+    while (true) {
+        const uint8_t k = (rand() % 33);
+
+        if ((total + k) > n_bits)
+            break;
+
+        vals[n] = (uint32_t)rand64();
+        lens[n] = k;
+
+        if (k < 32)
+            vals[n] &= ((UINT32_C(1) << k) - 1);
+
+        lrpt_decoder_bitop_write_n_bits(&b, vals[n], k);
+        total += k;
+        n++;
+    }
+
+    lrpt_decoder_bitop_write_n_bits(&b, 0, (8 - total % 8) % 8);
+    lrpt_decoder_bitop_writer_flush(&b);
+    ck_assert_int_eq(b.cur_len, 0);
+
+    lrpt_decoder_bitop_reader_set(&b, bytes, b.pos);
+
+    for (size_t i = 0; i < n; i++)
+        ck_assert_uint_eq(lrpt_decoder_bitop_pop_n_bits(&b, lens[i]), vals[i]);
+
+    /* Buffered reader gives the same values, it doesn't take empty reads */
+    const size_t len = b.len;
+
+    lrpt_decoder_bitop_reader_set(&b, bytes, len);
+
+    for (size_t i = 0; i < n; i++) {
+        if (lens[i] == 0)
+            continue;
+
+        lrpt_decoder_bitop_buf_refill(&b);
+        ck_assert_uint_eq(lrpt_decoder_bitop_buf_pop_n_bits(&b, lens[i]), vals[i]);
+    }
+}
+
+Suite *bitop_suite(void) {
+    Suite *s;
+    TCase *tc_count, *tc_write, *tc_read;
+
+    s = suite_create("Bit I/O");
+    tc_count = tcase_create("bit counting");
+    tc_write = tcase_create("writer");
+    tc_read = tcase_create("reader");
+
+    tcase_add_test(tc_count, test_count);
+    tcase_add_test(tc_write, test_write_aligned);
+    tcase_add_test(tc_write, test_write_random);
+    tcase_add_test(tc_read, test_read_random);
+    tcase_add_test(tc_read, test_buf_read_random);
+    tcase_add_test(tc_read, test_roundtrip);
+
+    suite_add_tcase(s, tc_count);
+    suite_add_tcase(s, tc_write);
+    suite_add_tcase(s, tc_read);
+
+    return s;
+}
+
+int main(void) {
+    int num_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = bitop_suite();
+    sr = srunner_create(s);
+
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_run_all(sr, CK_NORMAL);
+    num_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
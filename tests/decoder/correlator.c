@@ -0,0 +1,312 @@
+/*
+ * This file is part of liblrpt.
+ *
+ * liblrpt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liblrpt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liblrpt. If not, see https://www.gnu.org/licenses/
+ *
+ * Author: Viktor Drobot
+ */
+
+/*************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <check.h>
+
+#include "decoder/correlator.h"
+
+/*************************************************************************************************/
+
+static const uint64_t TEST_sync_enc = 0xFCA2B63DB00D9794; /* Convolutionally encoded sync word */
+static const uint8_t TEST_patterns = 8;
+static const size_t TEST_len = 16384; /* One soft frame */
+static const size_t TEST_offset = 1000; /* Sync position of the first pattern */
+static const size_t TEST_offset_step = 1537; /* Sync positions distance between patterns */
+static const uint16_t TEST_scan_min = 52; /* Random data never correlates that well */
+static const uint16_t TEST_psr_min = 30; /* Peak-to-sidelobe ratio of true sync (in tenths) */
+
+/*************************************************************************************************/
+
+/* Make soft symbols of sync word in the given phase. Every pair of bits is an (I, Q) symbol;
+ * flipped patterns have I and Q swapped, every rotation multiplies symbol by j
+ */
+static void make_sync(uint8_t pattern, int8_t sync[64]) {
+    for (uint8_t k = 0; k < 32; k++) {
+        int8_t i = ((TEST_sync_enc >> (63 - 2 * k)) & 0x01) ? 1 : -1;
+        int8_t q = ((TEST_sync_enc >> (62 - 2 * k)) & 0x01) ? 1 : -1;
+
+        if (pattern >= 4) {
+            const int8_t t = i;
+
+            i = q;
+            q = t;
+        }
+
+        for (uint8_t r = 0; r < (pattern % 4); r++) {
+            const int8_t t = i;
+
+            i = -q;
+            q = t;
+        }
+
+        sync[2 * k] = i;
+        sync[2 * k + 1] = q;
+    }
+}
+
+/* Random soft symbol with magnitude of at least min */
+static int8_t rand_soft(int8_t min) {
+    const int8_t v = (min + rand() % (128 - min));
+
+    return (rand() % 2) ? v : -v;
+}
+
+static void fill_random(int8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        data[i] = rand_soft(1);
+}
+
+/* Put sync word in the given phase to the data with errs symbols inverted */
+static void put_sync(int8_t *data, uint8_t pattern, uint8_t errs) {
+    int8_t sync[64];
+    bool flip[64] = { false };
+
+    make_sync(pattern, sync);
+
+    for (uint8_t e = 0; e < errs; ) {
+        const uint8_t j = (rand() % 64);
+
+        if (!flip[j]) {
+            flip[j] = true;
+            e++;
+        }
+    }
+
+    for (uint8_t j = 0; j < 64; j++) {
+        const int8_t v = rand_soft(20);
+
+        data[j] = ((v < 0) ? -v : v) * sync[j] * (flip[j] ? -1 : 1);
+    }
+}
+
+/*************************************************************************************************/
+
+START_TEST(test_patterns) {
+    lrpt_decoder_correlator_t *corr = lrpt_decoder_correlator_init();
+
+    ck_assert_ptr_nonnull(corr);
+    ck_assert(corr->patterns[0] == TEST_sync_enc);
+
+    for (uint8_t p = 0; p < TEST_patterns; p++) {
+        int8_t sync[64];
+        uint64_t bits = 0;
+
+        make_sync(p, sync);
+
+        for (uint8_t j = 0; j < 64; j++) {
+            bits = ((bits << 1) | (sync[j] > 0));
+            ck_assert_int_eq(corr->soft_patterns[p * 64 + j], sync[j]);
+        }
+
+        ck_assert(corr->patterns[p] == bits);
+
+        /* All phases are distinguishable */
+        for (uint8_t q = 0; q < p; q++)
+            ck_assert(corr->patterns[q] != corr->patterns[p]);
+    }
+
+    lrpt_decoder_correlator_deinit(corr);
+}
+
+START_TEST(test_correlate) {
+    lrpt_decoder_correlator_t *corr = lrpt_decoder_correlator_init();
+    int8_t *data = malloc(TEST_len * sizeof(int8_t));
+
+    ck_assert_ptr_nonnull(data);
+
+    srand(1);
+
+    for (uint8_t p = 0; p < TEST_patterns; p++) {
+        const size_t pos = (TEST_offset + p * TEST_offset_step);
+
+        /* Correlation over the limit is taken right away */
+        for (uint8_t errs = 0; errs <= 8; errs++) {
+            fill_random(data, TEST_len);
+            put_sync(data + pos, p, errs);
+
+            ck_assert_int_eq(lrpt_decoder_correlator_correlate(corr, data, TEST_len), p);
+            ck_assert_int_eq(corr->position[p], pos);
+            ck_assert_int_eq(corr->correlation[p], 64 - errs);
+        }
+
+        /* Otherwise the best one is found */
+        for (uint8_t errs = 9; errs <= 12; errs++) {
+            fill_random(data, TEST_len);
+            put_sync(data + pos, p, errs);
+
+            ck_assert_int_eq(lrpt_decoder_correlator_correlate(corr, data, TEST_len), p);
+            ck_assert_int_eq(corr->position[p], pos);
+            ck_assert_int_eq(corr->correlation[p], 64 - errs);
+        }
+    }
+
+    free(data);
+    lrpt_decoder_correlator_deinit(corr);
+}
+
+START_TEST(test_scan) {
+    lrpt_decoder_correlator_t *corr = lrpt_decoder_correlator_init();
+    int8_t *data = malloc(TEST_len * sizeof(int8_t));
+    lrpt_decoder_correlator_cand_t cands[4];
+    const size_t block = (TEST_len / 4);
+
+    ck_assert_ptr_nonnull(data);
+
+    srand(2);
+
+    /* Four phases at a time, one per block */
+    for (uint8_t first = 0; first < TEST_patterns; first += 4) {
+        fill_random(data, TEST_len);
+
+        for (uint8_t b = 0; b < 4; b++)
+            put_sync(data + b * block + TEST_offset + b, first + b, 2 * b);
+
+        ck_assert_int_eq(
+                lrpt_decoder_correlator_scan(corr, data, TEST_len, block, TEST_scan_min, cands, 4),
+                4);
+
+        for (uint8_t b = 0; b < 4; b++) {
+            ck_assert_int_eq(cands[b].position, b * block + TEST_offset + b);
+            ck_assert_int_eq(cands[b].pattern, first + b);
+            ck_assert_int_eq(cands[b].correlation, 64 - 2 * b);
+        }
+
+        /* Storage limit stops scan */
+        ck_assert_int_eq(
+                lrpt_decoder_correlator_scan(corr, data, TEST_len, block, TEST_scan_min, cands, 2),
+                2);
+        ck_assert_int_eq(cands[1].pattern, first + 1);
+
+        /* Weak candidates are dropped */
+        ck_assert_int_eq(
+                lrpt_decoder_correlator_scan(corr, data, TEST_len, block, 61, cands, 4),
+                2);
+        ck_assert_int_eq(cands[0].pattern, first);
+        ck_assert_int_eq(cands[1].pattern, first + 1);
+    }
+
+    /* Nothing but random data */
+    fill_random(data, TEST_len);
+    ck_assert_int_eq(
+            lrpt_decoder_correlator_scan(corr, data, TEST_len, block, TEST_scan_min, cands, 4),
+            0);
+
+    free(data);
+    lrpt_decoder_correlator_deinit(corr);
+}
+
+START_TEST(test_soft_correlate) {
+    lrpt_decoder_correlator_t *corr = lrpt_decoder_correlator_init();
+    int8_t *data = malloc(TEST_len * sizeof(int8_t));
+
+    ck_assert_ptr_nonnull(data);
+
+    srand(3);
+
+    for (uint8_t p = 0; p < TEST_patterns; p++) {
+        const size_t pos = (TEST_offset + p * TEST_offset_step);
+
+        for (uint8_t errs = 0; errs <= 12; errs += 4) {
+            int8_t sync[64];
+            int32_t peak = 0;
+            int32_t mag = 0;
+
+            fill_random(data, TEST_len);
+            put_sync(data + pos, p, errs);
+            make_sync(p, sync);
+
+            for (uint8_t j = 0; j < 64; j++) {
+                peak += data[pos + j] * sync[j];
+                mag += abs(data[pos + j]);
+            }
+
+            /* Correlation is normalized by the symbols magnitude */
+            lrpt_decoder_correlator_soft_correlate(corr, data + pos, p, 0);
+
+            const int8_t c = corr->soft_correlation;
+
+            ck_assert_int_eq(c, (100 * peak) / mag);
+            ck_assert_int_ge(corr->soft_psr, TEST_psr_min);
+
+            if (errs == 0)
+                ck_assert_int_eq(c, 100);
+
+            /* Sidelobes aren't calculated for weak correlation */
+            lrpt_decoder_correlator_soft_correlate(corr, data + pos, p, c + 1);
+            ck_assert_int_eq(corr->soft_correlation, c);
+            ck_assert_int_eq(corr->soft_psr, 0);
+
+            /* Other phases are worse */
+            for (uint8_t q = 0; q < TEST_patterns; q++) {
+                if (q == p)
+                    continue;
+
+                lrpt_decoder_correlator_soft_correlate(corr, data + pos, q, 0);
+                ck_assert_int_lt(corr->soft_correlation, c);
+            }
+
+            /* Right pattern at the wrong place */
+            lrpt_decoder_correlator_soft_correlate(corr, data + pos + 2, p, 0);
+            ck_assert_int_lt(corr->soft_correlation, c);
+        }
+    }
+
+    free(data);
+    lrpt_decoder_correlator_deinit(corr);
+}
+
+Suite *correlator_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Correlator");
+    tc_core = tcase_create("core");
+
+    tcase_add_test(tc_core, test_patterns);
+    tcase_add_test(tc_core, test_correlate);
+    tcase_add_test(tc_core, test_scan);
+    tcase_add_test(tc_core, test_soft_correlate);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int num_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = correlator_suite();
+    sr = srunner_create(s);
+
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_run_all(sr, CK_NORMAL);
+    num_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,409 @@
+/*
+ * This file is part of liblrpt.
+ *
+ * liblrpt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liblrpt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liblrpt. If not, see https://www.gnu.org/licenses/
+ *
+ * Author: Viktor Drobot
+ */
+
+/*************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <check.h>
+
+#include "decoder/ecc.h"
+
+/*************************************************************************************************/
+
+#define NEL(x) (sizeof(x) / sizeof((x)[0]))
+
+/*************************************************************************************************/
+
+static int TEST_rounds = 5000; /* Frames of 4 codewords */
+static uint8_t TEST_max_errors = 40; /* Maximum number of errors in codeword */
+
+/* Reed-Solomon (255, 223) code of CCSDS, conventional basis. For more information see
+ * https://public.ccsds.org/Pubs/131x0b4.pdf
+ */
+static uint16_t RS_POLY = 0x187; /* Field generator polynomial */
+static uint8_t RS_FCR = 112; /* First consecutive root */
+static uint8_t RS_PRIM = 11; /* Primitive element for roots */
+static uint8_t RS_DATA_LEN = 223;
+static uint8_t RS_NROOTS = 32;
+
+static uint8_t gf_alpha[255]; /* Polynomial form of alpha^i */
+static uint8_t gf_idx[256]; /* Index form, 255 stands for zero */
+static uint8_t rs_gen[33]; /* Generator polynomial, polynomial form, lowest degree first */
+
+/*************************************************************************************************/
+
+static uint8_t gf_mul(uint8_t a, uint8_t b) {
+    if ((a == 0) || (b == 0))
+        return 0;
+
+    return gf_alpha[(gf_idx[a] + gf_idx[b]) % 255];
+}
+
+static void rs_init(void) {
+    uint16_t x = 1;
+
+    for (uint8_t i = 0; i < 255; i++) {
+        gf_alpha[i] = x;
+        gf_idx[x] = i;
+
+        x <<= 1;
+
+        if (x & 0x100)
+            x ^= RS_POLY;
+    }
+
+    gf_idx[0] = 255;
+
+    /* Product of (x + alpha^(RS_PRIM * (RS_FCR + j))) */
+    memset(rs_gen, 0, sizeof(rs_gen));
+    rs_gen[0] = 1;
+
+    for (uint8_t j = 0; j < RS_NROOTS; j++) {
+        const uint8_t root = gf_alpha[(RS_PRIM * (RS_FCR + j)) % 255];
+
+        for (uint8_t i = (j + 1); i > 0; i--)
+            rs_gen[i] = rs_gen[i - 1] ^ gf_mul(rs_gen[i], root);
+
+        rs_gen[0] = gf_mul(rs_gen[0], root);
+    }
+}
+
+/* Systematic encoder, the first byte is the highest degree coefficient */
+static void rs_encode(uint8_t *cw) {
+    uint8_t p[32] = { 0 }; /* RS_NROOTS */
+
+    for (uint8_t i = 0; i < RS_DATA_LEN; i++) {
+        const uint8_t fb = (cw[i] ^ p[RS_NROOTS - 1]);
+
+        for (uint8_t j = (RS_NROOTS - 1); j > 0; j--)
+            p[j] = p[j - 1] ^ gf_mul(fb, rs_gen[j]);
+
+        p[0] = gf_mul(fb, rs_gen[0]);
+    }
+
+    for (uint8_t j = 0; j < RS_NROOTS; j++)
+        cw[RS_DATA_LEN + j] = p[RS_NROOTS - 1 - j];
+}
+
+/* Reference decoder: straightforward Berlekamp-Massey, Chien search and Forney algorithm in
+ * index form with modulo arithmetic, as the decoder used to be
+ */
+static bool rs_decode_ref(uint8_t *cw) {
+    uint8_t s[32]; /* RS_NROOTS */
+    uint8_t syn_error = 0;
+
+    for (int j = 0; j < RS_NROOTS; j++) {
+        uint8_t v = 0;
+
+        for (int i = 0; i < ECC_BUF_LEN; i++)
+            v = cw[i] ^ gf_mul(v, gf_alpha[(RS_PRIM * (RS_FCR + j)) % 255]);
+
+        syn_error |= v;
+        s[j] = gf_idx[v];
+    }
+
+    if (syn_error == 0)
+        return true;
+
+    /* Berlekamp-Massey, lambda is in polynomial form, b is in index form */
+    uint8_t lambda[33] = { 1 };
+    uint8_t b[33], t[33];
+    int el = 0;
+
+    for (int i = 0; i < 33; i++)
+        b[i] = gf_idx[lambda[i]];
+
+    for (int r = 1; r <= RS_NROOTS; r++) {
+        uint8_t discr = 0;
+
+        for (int i = 0; i < r; i++)
+            if ((lambda[i] != 0) && (s[r - i - 1] != 255))
+                discr ^= gf_alpha[(gf_idx[lambda[i]] + s[r - i - 1]) % 255];
+
+        const uint8_t discr_r = gf_idx[discr];
+
+        if (discr_r == 255) {
+            memmove((b + 1), b, 32);
+            b[0] = 255;
+
+            continue;
+        }
+
+        t[0] = lambda[0];
+
+        for (int i = 0; i < RS_NROOTS; i++)
+            t[i + 1] = (b[i] != 255) ? (lambda[i + 1] ^ gf_alpha[(discr_r + b[i]) % 255]) :
+                lambda[i + 1];
+
+        if ((2 * el) <= (r - 1)) {
+            el = (r - el);
+
+            for (int i = 0; i <= RS_NROOTS; i++)
+                b[i] = (lambda[i] == 0) ? 255 : ((gf_idx[lambda[i]] - discr_r + 255) % 255);
+        }
+        else {
+            memmove((b + 1), b, 32);
+            b[0] = 255;
+        }
+
+        memcpy(lambda, t, 33);
+    }
+
+    int deg_lambda = 0;
+
+    for (int i = 0; i < 33; i++) {
+        lambda[i] = gf_idx[lambda[i]];
+
+        if (lambda[i] != 255)
+            deg_lambda = i;
+    }
+
+    /* Chien search: X^-1 = alpha^(RS_PRIM * n) for error at byte (254 - loc) */
+    int root[32], loc[32];
+    int num_fixed = 0;
+
+    for (int n = 1; n <= 255; n++) {
+        uint8_t q = 0;
+
+        for (int i = 0; i <= deg_lambda; i++)
+            if (lambda[i] != 255)
+                q ^= gf_alpha[(lambda[i] + i * n) % 255];
+
+        if (q != 0)
+            continue;
+
+        /* Error locator X = alpha^(RS_PRIM * pos) where pos is the power of x */
+        const int x_log = ((255 - n) % 255);
+        int pos = 0;
+
+        while (((RS_PRIM * pos) % 255) != x_log)
+            pos++;
+
+        if (num_fixed < 32) {
+            root[num_fixed] = n;
+            loc[num_fixed] = (ECC_BUF_LEN - 1 - pos);
+        }
+
+        num_fixed++;
+    }
+
+    if (num_fixed != deg_lambda)
+        return false;
+
+    /* Forney algorithm, omega = s * lambda mod x^RS_NROOTS */
+    uint8_t omega[32];
+    const int deg_omega = (deg_lambda - 1);
+
+    for (int i = 0; i <= deg_omega; i++) {
+        uint8_t tmp = 0;
+
+        for (int j = i; j >= 0; j--)
+            if ((s[i - j] != 255) && (lambda[j] != 255))
+                tmp ^= gf_alpha[(s[i - j] + lambda[j]) % 255];
+
+        omega[i] = gf_idx[tmp];
+    }
+
+    for (int i = 0; i < num_fixed; i++) {
+        uint8_t num1 = 0;
+        uint8_t den = 0;
+
+        for (int j = 0; j <= deg_omega; j++)
+            if (omega[j] != 255)
+                num1 ^= gf_alpha[(omega[j] + j * root[i]) % 255];
+
+        /* X^(1 - RS_FCR) as X^-1 = alpha^root */
+        const uint8_t num2 = gf_alpha[(root[i] * (RS_FCR - 1)) % 255];
+
+        /* Formal derivative of lambda at X^-1, only odd terms are left */
+        for (int j = 1; j <= deg_lambda; j += 2)
+            if (lambda[j] != 255)
+                den ^= gf_alpha[(lambda[j] + (j - 1) * root[i]) % 255];
+
+        if (num1 != 0)
+            cw[loc[i]] ^= gf_alpha[(gf_idx[num1] + gf_idx[num2] + 255 - gf_idx[den]) % 255];
+    }
+
+    return true;
+}
+
+/* Random codewords with the given numbers of errors, interleaved as in the frame */
+static void make_frame(
+        uint8_t cw[][255],
+        uint8_t *orig,
+        uint8_t *data,
+        const uint8_t *n_errors) {
+    for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++) {
+        for (uint8_t i = 0; i < RS_DATA_LEN; i++)
+            cw[n][i] = rand();
+
+        rs_encode(cw[n]);
+        memcpy((orig + n * ECC_BUF_LEN), cw[n], ECC_BUF_LEN);
+
+        /* Errors at distinct positions */
+        bool hit[255] = { false };
+
+        for (uint8_t e = 0; e < n_errors[n]; ) {
+            const uint8_t pos = (rand() % ECC_BUF_LEN);
+            const uint8_t val = (1 + rand() % 255);
+
+            if (hit[pos])
+                continue;
+
+            hit[pos] = true;
+            cw[n][pos] ^= val;
+            e++;
+        }
+
+        for (uint8_t i = 0; i < ECC_BUF_LEN; i++)
+            data[i * ECC_CODEWORDS_NUM + n] = cw[n][i];
+    }
+}
+
+/*************************************************************************************************/
+
+START_TEST(test_encoder) {
+    uint8_t cw[4][255];
+    uint8_t orig[1020];
+    uint8_t data[1020];
+    bool results[4];
+    const uint8_t n_errors[4] = { 0, 0, 0, 0 };
+
+    /* Sanity check of the test itself: clean codewords have no syndromes */
+    srand(1);
+    make_frame(cw, orig, data, n_errors);
+
+    for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++) {
+        ck_assert(rs_decode_ref(cw[n]));
+        ck_assert_mem_eq(cw[n], (orig + n * ECC_BUF_LEN), ECC_BUF_LEN);
+    }
+
+    ck_assert(lrpt_decoder_ecc_decode(data, results));
+
+    for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++) {
+        ck_assert(results[n]);
+
+        for (uint8_t i = 0; i < ECC_BUF_LEN; i++)
+            ck_assert_int_eq(data[i * ECC_CODEWORDS_NUM + n], orig[n * ECC_BUF_LEN + i]);
+    }
+}
+
+START_TEST(test_correctable) {
+    uint8_t cw[4][255];
+    uint8_t orig[1020];
+    uint8_t data[1020];
+    bool results[4];
+
+    srand(2);
+
+    /* Up to 16 errors are always corrected */
+    for (int r = 0; r < (TEST_rounds / 4); r++) {
+        uint8_t n_errors[4];
+
+        for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++)
+            n_errors[n] = (rand() % (RS_NROOTS / 2 + 1));
+
+        make_frame(cw, orig, data, n_errors);
+
+        ck_assert(lrpt_decoder_ecc_decode(data, results));
+
+        for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++) {
+            ck_assert(results[n]);
+
+            for (uint8_t i = 0; i < ECC_BUF_LEN; i++)
+                ck_assert_int_eq(data[i * ECC_CODEWORDS_NUM + n], orig[n * ECC_BUF_LEN + i]);
+        }
+    }
+}
+
+START_TEST(test_reference) {
+    uint8_t cw[4][255];
+    uint8_t orig[1020];
+    uint8_t data[1020];
+    bool results[4];
+
+    srand(3);
+
+    /* Beyond correction capability decoder should fail or miscorrect just as reference does */
+    for (int r = 0; r < TEST_rounds; r++) {
+        uint8_t n_errors[4];
+
+        for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++)
+            n_errors[n] = (rand() % (TEST_max_errors + 1));
+
+        make_frame(cw, orig, data, n_errors);
+
+        bool ok = lrpt_decoder_ecc_decode(data, results);
+        bool ref_ok = true;
+
+        for (uint8_t n = 0; n < ECC_CODEWORDS_NUM; n++) {
+            const bool ref = rs_decode_ref(cw[n]);
+
+            ck_assert_int_eq(results[n], ref);
+            ref_ok = (ref_ok && ref);
+
+            /* Failed codewords may be left partially corrected, compare only decoded ones */
+            if (!ref)
+                continue;
+
+            for (uint8_t i = 0; i < ECC_BUF_LEN; i++)
+                ck_assert_int_eq(data[i * ECC_CODEWORDS_NUM + n], cw[n][i]);
+        }
+
+        ck_assert_int_eq(ok, ref_ok);
+    }
+}
+
+Suite *ecc_suite(void) {
+    Suite *s;
+    TCase *tc_decode;
+
+    rs_init();
+
+    s = suite_create("ECC");
+    tc_decode = tcase_create("decoding");
+
+    tcase_add_test(tc_decode, test_encoder);
+    tcase_add_test(tc_decode, test_correctable);
+    tcase_add_test(tc_decode, test_reference);
+
+    suite_add_tcase(s, tc_decode);
+
+    return s;
+}
+
+int main(void) {
+    int num_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = ecc_suite();
+    sr = srunner_create(s);
+
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_run_all(sr, CK_NORMAL);
+    num_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,344 @@
+/*
+ * This file is part of liblrpt.
+ *
+ * liblrpt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liblrpt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liblrpt. If not, see https://www.gnu.org/licenses/
+ *
+ * Author: Viktor Drobot
+ */
+
+/*************************************************************************************************/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <check.h>
+
+#include "lrpt.h"
+#include "decoder/jpeg.h"
+
+/*************************************************************************************************/
+
+#define NEL(x) (sizeof(x) / sizeof((x)[0]))
+
+/*************************************************************************************************/
+
+static size_t TEST_width = 1568; /* Meteor-M2 channel image width */
+static uint16_t TEST_first_pck = 1000; /* Packet counter of the first packet */
+static uint8_t TEST_pck_mcus = 14; /* MCUs per packet */
+static uint8_t TEST_row_pcks = 43; /* Packets per MCU row of all channels */
+static uint8_t TEST_q = 80; /* Quality */
+static uint8_t TEST_row_len = 14; /* Packets per MCU row of single channel */
+static int TEST_idct_rounds = 2000; /* Random blocks per IDCT path */
+static const double TEST_pi = 3.14159265358979323846;
+
+/* Natural order index of zigzag order coefficient */
+static const uint8_t TEST_natural[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/* 14 MCUs with all-zero coefficients: DC category 0 ("00") and end of block ("1010") each,
+ * padded with ones. Such MCUs are flat grey (128)
+ */
+static uint8_t TEST_mcus[] = {
+    0x28, 0xA2, 0x8A, 0x28, 0xA2, 0x8A, 0x28, 0xA2, 0x8A, 0x28, 0xAF
+};
+
+/* Rows reported by callback */
+typedef struct test_rows__ {
+    size_t n; /* Number of callback calls */
+    uint8_t apid[16];
+    size_t line[16];
+    size_t n_lines[16];
+    size_t width[16];
+    bool grey[16]; /* Whether all pixels of rows are flat grey */
+} test_rows_t;
+
+/*************************************************************************************************/
+
+static void rows_cb(
+        uint8_t apid,
+        const uint8_t *pxls,
+        size_t line,
+        size_t n_lines,
+        size_t width,
+        void *user_data) {
+    test_rows_t *rows = user_data;
+
+    if (rows->n >= NEL(rows->line))
+        return;
+
+    rows->apid[rows->n] = apid;
+    rows->line[rows->n] = line;
+    rows->n_lines[rows->n] = n_lines;
+    rows->width[rows->n] = width;
+    rows->grey[rows->n] = true;
+
+    for (size_t i = 0; i < (n_lines * width); i++)
+        if (pxls[i] != 128)
+            rows->grey[rows->n] = false;
+
+    rows->n++;
+}
+
+/* Random block of dequantized coefficients with given last non-zero one (in zigzag order) */
+static void make_block(int32_t *dct, uint8_t last) {
+    memset(dct, 0, sizeof(int32_t) * 64);
+
+    dct[0] = ((rand() % 1601) - 800);
+
+    for (uint8_t k = 1; k <= last; k++)
+        dct[TEST_natural[k]] = ((rand() % 201) - 100);
+
+    if (last > 0)
+        dct[TEST_natural[last]] = ((rand() % 2) ? 1 : -1) * (1 + rand() % 100);
+}
+
+/* Reference separable floating-point IDCT */
+static void ref_idct(const int32_t *dct, uint8_t *res) {
+    double tmp[64];
+
+    for (uint8_t i = 0; i < 8; i++)
+        for (uint8_t x = 0; x < 8; x++) {
+            double s = 0;
+
+            for (uint8_t u = 0; u < 8; u++)
+                s += ((u == 0) ? (1.0 / sqrt(2.0)) : 1.0) * dct[i * 8 + u] *
+                    cos((2.0 * x + 1.0) * u * TEST_pi / 16.0);
+
+            tmp[i * 8 + x] = (s / 2.0);
+        }
+
+    for (uint8_t y = 0; y < 8; y++)
+        for (uint8_t x = 0; x < 8; x++) {
+            double s = 0;
+
+            for (uint8_t i = 0; i < 8; i++)
+                s += ((i == 0) ? (1.0 / sqrt(2.0)) : 1.0) * tmp[i * 8 + x] *
+                    cos((2.0 * y + 1.0) * i * TEST_pi / 16.0);
+
+            const double t = round(s / 2.0 + 128.0);
+
+            res[y * 8 + x] = (t < 0) ? 0 : ((t > 255) ? 255 : t);
+        }
+}
+
+/* Feed packets [first; last) of MCU row (left to right) */
+static void feed_row(
+        lrpt_decoder_t *decoder,
+        uint16_t apid,
+        size_t row,
+        uint8_t first,
+        uint8_t last) {
+    for (uint8_t j = first; j < last; j++) {
+        /* Channels go one after another within the row */
+        const uint16_t pck_cnt =
+            (TEST_first_pck + row * TEST_row_pcks + (apid - 64) * TEST_pck_mcus + j);
+
+        ck_assert(lrpt_decoder_jpeg_decode_mcus(
+                    decoder,
+                    TEST_mcus,
+                    sizeof(TEST_mcus),
+                    apid,
+                    pck_cnt,
+                    (j * TEST_pck_mcus),
+                    TEST_q));
+    }
+}
+
+/*************************************************************************************************/
+
+START_TEST(test_rows_complete) {
+    lrpt_decoder_t *decoder = lrpt_decoder_init(LRPT_DECODER_SC_METEORM2, NULL);
+    test_rows_t rows = { 0 };
+
+    lrpt_decoder_set_rows_cb(decoder, rows_cb, &rows);
+
+    /* Every complete row is reported once, right after its rightmost MCU */
+    for (size_t r = 0; r < 3; r++) {
+        feed_row(decoder, 64, r, 0, (TEST_row_len - 1));
+        ck_assert_int_eq(rows.n, r);
+
+        feed_row(decoder, 64, r, (TEST_row_len - 1), TEST_row_len);
+        ck_assert_int_eq(rows.n, (r + 1));
+    }
+
+    for (size_t i = 0; i < rows.n; i++) {
+        ck_assert_int_eq(rows.apid[i], 64);
+        ck_assert_int_eq(rows.line[i], (8 * i));
+        ck_assert_int_eq(rows.n_lines[i], 8);
+        ck_assert_int_eq(rows.width[i], TEST_width);
+        ck_assert(rows.grey[i]);
+    }
+
+    lrpt_decoder_deinit(decoder);
+}
+
+START_TEST(test_rows_partial) {
+    lrpt_decoder_t *decoder = lrpt_decoder_init(LRPT_DECODER_SC_METEORM2, NULL);
+    test_rows_t rows = { 0 };
+
+    lrpt_decoder_set_rows_cb(decoder, rows_cb, &rows);
+
+    /* Two channels, rightmost MCUs of the second row are lost for the first channel */
+    feed_row(decoder, 64, 0, 0, TEST_row_len);
+    feed_row(decoder, 65, 0, 0, TEST_row_len);
+    feed_row(decoder, 64, 1, 0, 5);
+    feed_row(decoder, 65, 1, 0, TEST_row_len);
+
+    ck_assert_int_eq(rows.n, 3);
+
+    /* Row with lost MCUs is reported when channel moves on to the next row */
+    feed_row(decoder, 64, 2, 0, 1);
+    ck_assert_int_eq(rows.n, 4);
+
+    const uint8_t apids[] = { 64, 65, 65, 64 };
+    const size_t lines[] = { 0, 0, 8, 8 };
+
+    for (size_t i = 0; i < rows.n; i++) {
+        ck_assert_int_eq(rows.apid[i], apids[i]);
+        ck_assert_int_eq(rows.line[i], lines[i]);
+        ck_assert_int_eq(rows.n_lines[i], 8);
+        ck_assert_int_eq(rows.width[i], TEST_width);
+    }
+
+    /* Lost MCUs are left black */
+    ck_assert(rows.grey[0] && rows.grey[1] && rows.grey[2] && !rows.grey[3]);
+
+    /* Callback is disabled */
+    lrpt_decoder_set_rows_cb(decoder, NULL, NULL);
+    feed_row(decoder, 64, 2, 1, TEST_row_len);
+    ck_assert_int_eq(rows.n, 4);
+
+    lrpt_decoder_deinit(decoder);
+}
+
+START_TEST(test_idct) {
+    lrpt_decoder_jpeg_t *jpeg = lrpt_decoder_jpeg_init();
+    int32_t dct[64];
+    uint8_t pix[64], full[64], ref[64];
+
+    ck_assert_ptr_nonnull(jpeg);
+
+    srand(1);
+
+    /* DC-only, 4x4 corner and full blocks */
+    const uint8_t lasts[3][2] = { { 0, 0 }, { 1, 9 }, { 10, 63 } };
+
+    for (uint8_t n = 0; n < 3; n++)
+        for (int i = 0; i < TEST_idct_rounds; i++) {
+            const uint8_t lo = lasts[n][0];
+            const uint8_t last = (lo + rand() % (lasts[n][1] - lo + 1));
+
+            make_block(dct, last);
+
+            /* Shortcuts give exactly the same result as the full transform */
+            lrpt_decoder_jpeg_idct_8x8(jpeg, pix, dct, last);
+            lrpt_decoder_jpeg_idct_8x8(jpeg, full, dct, 63);
+            ck_assert_mem_eq(pix, full, 64);
+
+            /* and they are accurate to one level */
+            ref_idct(dct, ref);
+
+            for (uint8_t j = 0; j < 64; j++)
+                ck_assert_int_le(abs(pix[j] - ref[j]), 1);
+        }
+
+    lrpt_decoder_jpeg_deinit(jpeg);
+}
+
+#ifndef LIBLRPT_JPEG_FLOAT_IDCT
+START_TEST(test_idct_paths) {
+    lrpt_decoder_jpeg_t *jpeg = lrpt_decoder_jpeg_init();
+    int32_t dct[64];
+    uint8_t pix[64];
+
+    ck_assert_ptr_nonnull(jpeg);
+    ck_assert_int_eq(jpeg->idct_dc_cnt, 0);
+    ck_assert_int_eq(jpeg->idct_sparse_cnt, 0);
+    ck_assert_int_eq(jpeg->idct_full_cnt, 0);
+
+    srand(2);
+
+    /* DC coefficient only */
+    make_block(dct, 0);
+    lrpt_decoder_jpeg_idct_8x8(jpeg, pix, dct, 0);
+    ck_assert_int_eq(jpeg->idct_dc_cnt, 1);
+
+    /* The last coefficient is still in the top-left 4x4 corner */
+    for (uint8_t last = 1; last <= 9; last++) {
+        make_block(dct, last);
+        lrpt_decoder_jpeg_idct_8x8(jpeg, pix, dct, last);
+        ck_assert_int_eq(jpeg->idct_sparse_cnt, last);
+    }
+
+    /* and it's outside of the corner */
+    for (uint8_t last = 10; last < 64; last++) {
+        make_block(dct, last);
+        lrpt_decoder_jpeg_idct_8x8(jpeg, pix, dct, last);
+        ck_assert_int_eq(jpeg->idct_full_cnt, last - 9);
+    }
+
+    ck_assert_int_eq(jpeg->idct_dc_cnt, 1);
+    ck_assert_int_eq(jpeg->idct_sparse_cnt, 9);
+
+    lrpt_decoder_jpeg_deinit(jpeg);
+}
+#endif
+
+Suite *jpeg_suite(void) {
+    Suite *s;
+    TCase *tc_rows, *tc_idct;
+
+    s = suite_create("JPEG decoder");
+    tc_rows = tcase_create("rows callback");
+    tc_idct = tcase_create("IDCT");
+
+    tcase_add_test(tc_rows, test_rows_complete);
+    tcase_add_test(tc_rows, test_rows_partial);
+    tcase_add_test(tc_idct, test_idct);
+#ifndef LIBLRPT_JPEG_FLOAT_IDCT
+    tcase_add_test(tc_idct, test_idct_paths);
+#endif
+
+    suite_add_tcase(s, tc_rows);
+    suite_add_tcase(s, tc_idct);
+
+    return s;
+}
+
+int main(void) {
+    int num_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = jpeg_suite();
+    sr = srunner_create(s);
+
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_run_all(sr, CK_NORMAL);
+    num_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,352 @@
+/*
+ * This file is part of liblrpt.
+ *
+ * liblrpt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liblrpt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liblrpt. If not, see https://www.gnu.org/licenses/
+ *
+ * Author: Viktor Drobot
+ */
+
+/*************************************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <check.h>
+
+#include "decoder/viterbi.h"
+
+/*************************************************************************************************/
+
+static const size_t TEST_frame_len = 1024; /* Decoded frame length (in bytes) */
+static const size_t TEST_flush_len = 4; /* Bytes encoded into the flush symbols */
+static const uint8_t TEST_poly_a = 0x4F;
+static const uint8_t TEST_poly_b = 0x6D;
+static const int8_t TEST_amp = 100; /* Amplitude of noiseless soft symbols */
+static const double TEST_pi = 3.14159265358979323846;
+static const size_t TEST_guard_len = 16; /* Guard bytes past the end of output */
+static const int8_t TEST_weak_amp = 8; /* Amplitude of unreliable soft symbols */
+static const uint8_t TEST_weak_percent = 10; /* Share of unreliable symbols with wrong sign */
+static const uint8_t TEST_erased_percent = 10; /* Share of zero soft symbols */
+static int TEST_frames = 100;
+static double TEST_noise = 0.53; /* Noise deviation relative to amplitude, 3% wrong signs */
+static double TEST_heavy_noise = 0.77; /* 10% wrong signs, Eb/N0 is about 2.3 dB */
+static double TEST_heavy_ber = 0.005; /* Decoded bits error rate limit for heavy noise */
+
+/*************************************************************************************************/
+
+static uint8_t parity(uint8_t x) {
+    uint8_t p = 0;
+
+    for (; x; x >>= 1)
+        p ^= (x & 0x01);
+
+    return p;
+}
+
+/* Reference rate 1/2, K = 7 encoder, MSB of the first byte goes first. Zero parity bit is the
+ * positive soft symbol
+ */
+static void encode(const uint8_t *bytes, size_t len, int8_t *soft) {
+    uint8_t sr = 0;
+
+    for (size_t i = 0; i < (8 * len); i++) {
+        sr = (((sr << 1) | ((bytes[i / 8] >> (7 - i % 8)) & 0x01)) & 0x7F);
+
+        soft[2 * i] = parity(sr & TEST_poly_a) ? -TEST_amp : TEST_amp;
+        soft[2 * i + 1] = parity(sr & TEST_poly_b) ? -TEST_amp : TEST_amp;
+    }
+}
+
+/* Random frame with flush bytes */
+static void make_frame(uint8_t *bytes) {
+    for (size_t i = 0; i < (TEST_frame_len + TEST_flush_len); i++)
+        bytes[i] = (rand() & 0xFF);
+}
+
+/* Gaussian noise with given standard deviation */
+static double gauss(double sigma) {
+    const double u1 = ((rand() + 1.0) / (RAND_MAX + 2.0));
+    const double u2 = ((rand() + 1.0) / (RAND_MAX + 2.0));
+
+    return (sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * TEST_pi * u2));
+}
+
+static int8_t clip(double v) {
+    if (v > 127.0)
+        return 127;
+    else if (v < -128.0)
+        return -128;
+
+    return (int8_t)lrint(v);
+}
+
+/* Add noise to the encoded frame, return number of symbols in frame which changed sign */
+static size_t add_noise(int8_t *soft, double sigma) {
+    size_t flips = 0;
+
+    for (size_t i = 0; i < (16 * (TEST_frame_len + TEST_flush_len)); i++) {
+        const int8_t v = clip(soft[i] + gauss(sigma));
+
+        if (i < (16 * TEST_frame_len))
+            flips += ((v < 0) != (soft[i] < 0));
+
+        soft[i] = v;
+    }
+
+    return flips;
+}
+
+static size_t bit_errors(const uint8_t *a, const uint8_t *b, size_t len) {
+    size_t n = 0;
+
+    for (size_t i = 0; i < len; i++)
+        for (uint8_t x = (a[i] ^ b[i]); x; x >>= 1)
+            n += (x & 0x01);
+
+    return n;
+}
+
+/*************************************************************************************************/
+
+START_TEST(test_clean) {
+    lrpt_decoder_viterbi_t *vit = lrpt_decoder_viterbi_init();
+    uint8_t *bytes = malloc(TEST_frame_len + TEST_flush_len);
+    uint8_t *out = malloc(TEST_frame_len);
+    int8_t *soft = malloc(16 * (TEST_frame_len + TEST_flush_len));
+
+    ck_assert_ptr_nonnull(vit);
+    ck_assert_ptr_nonnull(bytes);
+    ck_assert_ptr_nonnull(out);
+    ck_assert_ptr_nonnull(soft);
+
+    srand(1);
+
+    for (int f = 0; f < TEST_frames; f++) {
+        make_frame(bytes);
+        encode(bytes, TEST_frame_len + TEST_flush_len, soft);
+
+        lrpt_decoder_viterbi_decode(vit, soft, out);
+
+        ck_assert_mem_eq(out, bytes, TEST_frame_len);
+        ck_assert_int_eq(lrpt_decoder_viterbi_ber_percent(vit), 0);
+    }
+
+    free(soft);
+    free(out);
+    free(bytes);
+    lrpt_decoder_viterbi_deinit(vit);
+}
+
+START_TEST(test_noise) {
+    lrpt_decoder_viterbi_t *vit = lrpt_decoder_viterbi_init();
+    uint8_t *bytes = malloc(TEST_frame_len + TEST_flush_len);
+    uint8_t *out = malloc(TEST_frame_len);
+    int8_t *soft = malloc(16 * (TEST_frame_len + TEST_flush_len));
+
+    ck_assert_ptr_nonnull(vit);
+    ck_assert_ptr_nonnull(bytes);
+    ck_assert_ptr_nonnull(out);
+    ck_assert_ptr_nonnull(soft);
+
+    srand(2);
+
+    /* Noise is well within code's reach */
+    for (int f = 0; f < TEST_frames; f++) {
+        make_frame(bytes);
+        encode(bytes, TEST_frame_len + TEST_flush_len, soft);
+
+        const size_t flips = add_noise(soft, TEST_noise * TEST_amp);
+
+        lrpt_decoder_viterbi_decode(vit, soft, out);
+
+        ck_assert_mem_eq(out, bytes, TEST_frame_len);
+
+        /* BER is estimated from re-encoded output so it's exactly the share of flipped signs */
+        ck_assert_int_eq(
+                lrpt_decoder_viterbi_ber_percent(vit),
+                100 * flips / (16 * TEST_frame_len));
+        ck_assert_int_ge(lrpt_decoder_viterbi_ber_percent(vit), 2);
+    }
+
+    free(soft);
+    free(out);
+    free(bytes);
+    lrpt_decoder_viterbi_deinit(vit);
+}
+
+START_TEST(test_output) {
+    lrpt_decoder_viterbi_t *vit = lrpt_decoder_viterbi_init();
+    uint8_t *bytes = malloc(TEST_frame_len + TEST_flush_len);
+    uint8_t *out = malloc(TEST_frame_len + TEST_guard_len);
+    uint8_t guard[16]; /* TEST_guard_len */
+    int8_t *soft = malloc(16 * (TEST_frame_len + TEST_flush_len));
+
+    ck_assert_ptr_nonnull(vit);
+    ck_assert_ptr_nonnull(bytes);
+    ck_assert_ptr_nonnull(out);
+    ck_assert_ptr_nonnull(soft);
+
+    srand(4);
+
+    /* Traced back bits overwrite stale output and decoding stops right at the frame end */
+    for (int f = 0; f < TEST_frames; f++) {
+        const uint8_t fill = (f % 2) ? 0xFF : 0x00;
+
+        memset(out, fill, TEST_frame_len + TEST_guard_len);
+        memset(guard, fill, TEST_guard_len);
+
+        /* All-zero and all-one frames in between random ones */
+        if ((f % 10) == 0)
+            memset(bytes, fill, TEST_frame_len + TEST_flush_len);
+        else
+            make_frame(bytes);
+
+        encode(bytes, TEST_frame_len + TEST_flush_len, soft);
+
+        /* Every other frame is a noisy one so decoder state should be reset between frames */
+        if ((f % 2) == 0)
+            add_noise(soft, TEST_noise * TEST_amp);
+
+        lrpt_decoder_viterbi_decode(vit, soft, out);
+
+        ck_assert_mem_eq(out, bytes, TEST_frame_len);
+        ck_assert_mem_eq(out + TEST_frame_len, guard, TEST_guard_len);
+    }
+
+    free(soft);
+    free(out);
+    free(bytes);
+    lrpt_decoder_viterbi_deinit(vit);
+}
+
+START_TEST(test_soft_metrics) {
+    lrpt_decoder_viterbi_t *vit = lrpt_decoder_viterbi_init();
+    uint8_t *bytes = malloc(TEST_frame_len + TEST_flush_len);
+    uint8_t *out = malloc(TEST_frame_len);
+    int8_t *soft = malloc(16 * (TEST_frame_len + TEST_flush_len));
+    const size_t len = (16 * (TEST_frame_len + TEST_flush_len));
+
+    ck_assert_ptr_nonnull(vit);
+    ck_assert_ptr_nonnull(bytes);
+    ck_assert_ptr_nonnull(out);
+    ck_assert_ptr_nonnull(soft);
+
+    srand(5);
+
+    for (int f = 0; f < TEST_frames; f++) {
+        make_frame(bytes);
+        encode(bytes, TEST_frame_len + TEST_flush_len, soft);
+
+        /* Too many wrong signs for hard decisions, but they all are unreliable */
+        for (size_t i = 0; i < len; i++)
+            if ((rand() % 100) < TEST_weak_percent)
+                soft[i] = (soft[i] < 0) ? TEST_weak_amp : -TEST_weak_amp;
+
+        lrpt_decoder_viterbi_decode(vit, soft, out);
+        ck_assert_mem_eq(out, bytes, TEST_frame_len);
+
+        /* Zero symbols carry no information */
+        encode(bytes, TEST_frame_len + TEST_flush_len, soft);
+
+        for (size_t i = 0; i < len; i++)
+            if ((rand() % 100) < TEST_erased_percent)
+                soft[i] = 0;
+
+        lrpt_decoder_viterbi_decode(vit, soft, out);
+        ck_assert_mem_eq(out, bytes, TEST_frame_len);
+
+        /* Full scale symbols don't overflow metrics */
+        encode(bytes, TEST_frame_len + TEST_flush_len, soft);
+
+        for (size_t i = 0; i < len; i++)
+            soft[i] = (soft[i] < 0) ? -128 : 127;
+
+        lrpt_decoder_viterbi_decode(vit, soft, out);
+        ck_assert_mem_eq(out, bytes, TEST_frame_len);
+        ck_assert_int_eq(lrpt_decoder_viterbi_ber_percent(vit), 0);
+    }
+
+    free(soft);
+    free(out);
+    free(bytes);
+    lrpt_decoder_viterbi_deinit(vit);
+}
+
+START_TEST(test_heavy_noise) {
+    lrpt_decoder_viterbi_t *vit = lrpt_decoder_viterbi_init();
+    uint8_t *bytes = malloc(TEST_frame_len + TEST_flush_len);
+    uint8_t *out = malloc(TEST_frame_len);
+    int8_t *soft = malloc(16 * (TEST_frame_len + TEST_flush_len));
+    size_t errs = 0;
+
+    ck_assert_ptr_nonnull(vit);
+    ck_assert_ptr_nonnull(bytes);
+    ck_assert_ptr_nonnull(out);
+    ck_assert_ptr_nonnull(soft);
+
+    srand(3);
+
+    /* Close to the limits of the code only maximum likelihood decoding keeps errors rare */
+    for (int f = 0; f < TEST_frames; f++) {
+        make_frame(bytes);
+        encode(bytes, TEST_frame_len + TEST_flush_len, soft);
+        add_noise(soft, TEST_heavy_noise * TEST_amp);
+
+        lrpt_decoder_viterbi_decode(vit, soft, out);
+        errs += bit_errors(out, bytes, TEST_frame_len);
+    }
+
+    ck_assert_int_lt(errs, TEST_heavy_ber * 8 * TEST_frame_len * TEST_frames);
+
+    free(soft);
+    free(out);
+    free(bytes);
+    lrpt_decoder_viterbi_deinit(vit);
+}
+
+Suite *viterbi_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Viterbi decoder");
+    tc_core = tcase_create("core");
+
+    tcase_add_test(tc_core, test_clean);
+    tcase_add_test(tc_core, test_noise);
+    tcase_add_test(tc_core, test_output);
+    tcase_add_test(tc_core, test_soft_metrics);
+    tcase_add_test(tc_core, test_heavy_noise);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int num_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = viterbi_suite();
+    sr = srunner_create(s);
+
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_run_all(sr, CK_NORMAL);
+    num_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
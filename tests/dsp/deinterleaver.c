@@ -0,0 +1,237 @@
+/*
+ * This file is part of liblrpt.
+ *
+ * liblrpt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liblrpt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liblrpt. If not, see https://www.gnu.org/licenses/
+ *
+ * Author: Viktor Drobot
+ */
+
+/*************************************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <check.h>
+
+#include "lrpt.h"
+
+/*************************************************************************************************/
+
+static size_t TEST_len = 200000;
+static size_t TEST_sparse_step = 997; /* Distance between non-zero symbols in sparse stream */
+
+static const size_t TEST_blocks = 2000; /* Number of sync + data blocks in synthetic stream */
+static const uint8_t TEST_block_len = 80; /* Sync word and interleaved data (in soft symbols) */
+static const uint8_t TEST_sync = 0x27; /* Sync byte, the first symbol is the LSB */
+static const int8_t TEST_amp = 100; /* Amplitude of soft symbols */
+
+/*************************************************************************************************/
+
+/* Make stream of sync words followed by random data. Every period-th block has flips sync bits
+ * inverted, bit positions rotate from block to block
+ */
+static lrpt_qpsk_data_t *make_stream(uint8_t flips, size_t period) {
+    const size_t len = (TEST_blocks * TEST_block_len);
+    int8_t *sdata = malloc(len * sizeof(int8_t));
+
+    ck_assert_ptr_nonnull(sdata);
+
+    srand(2);
+
+    for (size_t k = 0; k < TEST_blocks; k++) {
+        int8_t *p = (sdata + k * TEST_block_len);
+        uint8_t sync = TEST_sync;
+
+        if ((k % period) == (period / 2)) {
+            for (uint8_t j = 0; j < flips; j++)
+                sync ^= (1 << ((k + j) % 8));
+        }
+
+        for (uint8_t i = 0; i < 8; i++)
+            p[i] = ((sync >> i) & 0x01) ? TEST_amp : -TEST_amp;
+
+        for (uint8_t i = 8; i < TEST_block_len; i++)
+            p[i] = (rand() % 2) ? TEST_amp : -TEST_amp;
+    }
+
+    lrpt_qpsk_data_t *data = lrpt_qpsk_data_create_from_soft(sdata, 0, len / 2, NULL);
+
+    ck_assert_ptr_nonnull(data);
+    free(sdata);
+
+    return data;
+}
+
+/* Deinterleave stream with given sync threshold, return resulting length or 0 on failure */
+static size_t exec_stream(lrpt_qpsk_data_t *data, uint8_t thresh) {
+    lrpt_dsp_deinterleaver_t *deintlv = lrpt_dsp_deinterleaver_init(NULL);
+    size_t len = 0;
+
+    ck_assert(lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, thresh, NULL));
+
+    if (lrpt_dsp_deinterleaver_exec(deintlv, data, NULL))
+        len = lrpt_qpsk_data_length(data);
+
+    lrpt_dsp_deinterleaver_deinit(deintlv);
+    lrpt_qpsk_data_free(data);
+
+    return len;
+}
+
+/*************************************************************************************************/
+
+START_TEST(test_alloc) {
+    lrpt_dsp_deinterleaver_t *deintlv = lrpt_dsp_deinterleaver_init(NULL);
+
+    ck_assert_ptr_nonnull(deintlv);
+
+    lrpt_dsp_deinterleaver_deinit(deintlv);
+}
+
+START_TEST(test_sync_thresh) {
+    lrpt_dsp_deinterleaver_t *deintlv = lrpt_dsp_deinterleaver_init(NULL);
+
+    /* NULL pointer */
+    ck_assert(!lrpt_dsp_deinterleaver_set_sync_thresh(NULL, 70, NULL));
+
+    /* out of range */
+    ck_assert(!lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, 0, NULL));
+    ck_assert(!lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, 49, NULL));
+    ck_assert(!lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, 101, NULL));
+    ck_assert(!lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, 255, NULL));
+
+    /* range bounds and default value */
+    ck_assert(lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, 50, NULL));
+    ck_assert(lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, 100, NULL));
+    ck_assert(lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, 70, NULL));
+
+    lrpt_dsp_deinterleaver_deinit(deintlv);
+}
+
+START_TEST(test_exec_null) {
+    lrpt_dsp_deinterleaver_t *deintlv = lrpt_dsp_deinterleaver_init(NULL);
+    lrpt_qpsk_data_t *data = lrpt_qpsk_data_alloc(TEST_len, NULL);
+
+    ck_assert(!lrpt_dsp_deinterleaver_exec(NULL, data, NULL));
+    ck_assert(!lrpt_dsp_deinterleaver_exec(deintlv, NULL, NULL));
+    ck_assert_int_eq(lrpt_qpsk_data_length(data), TEST_len); /* data is left untouched */
+
+    lrpt_qpsk_data_free(data);
+    lrpt_dsp_deinterleaver_deinit(deintlv);
+}
+
+START_TEST(test_exec_zero) {
+    lrpt_dsp_deinterleaver_t *deintlv = lrpt_dsp_deinterleaver_init(NULL);
+    lrpt_qpsk_data_t *data = lrpt_qpsk_data_alloc(TEST_len, NULL);
+
+    /* all-zero stream is all ones after hard decision, so it's synced and must terminate */
+    ck_assert(lrpt_dsp_deinterleaver_exec(deintlv, data, NULL));
+    ck_assert_int_gt(lrpt_qpsk_data_length(data), 0);
+    ck_assert_int_lt(lrpt_qpsk_data_length(data), TEST_len);
+
+    lrpt_qpsk_data_free(data);
+    lrpt_dsp_deinterleaver_deinit(deintlv);
+}
+
+START_TEST(test_exec_sparse) {
+    lrpt_dsp_deinterleaver_t *deintlv = lrpt_dsp_deinterleaver_init(NULL);
+    int8_t *sdata = calloc(2 * TEST_len, sizeof(int8_t));
+
+    ck_assert_ptr_nonnull(sdata);
+
+    /* mostly-zero stream with rare random symbols, it must terminate with any result */
+    srand(1);
+
+    for (size_t i = 0; i < (2 * TEST_len); i += TEST_sparse_step)
+        sdata[i] = (rand() % 255) - 127;
+
+    lrpt_qpsk_data_t *data = lrpt_qpsk_data_create_from_soft(sdata, 0, TEST_len, NULL);
+
+    if (lrpt_dsp_deinterleaver_exec(deintlv, data, NULL))
+        ck_assert_int_lt(lrpt_qpsk_data_length(data), TEST_len);
+
+    /* the same with the lowest threshold */
+    ck_assert(lrpt_dsp_deinterleaver_set_sync_thresh(deintlv, 50, NULL));
+    ck_assert(lrpt_qpsk_data_from_soft(data, sdata, 0, TEST_len, NULL));
+
+    if (lrpt_dsp_deinterleaver_exec(deintlv, data, NULL))
+        ck_assert_int_lt(lrpt_qpsk_data_length(data), TEST_len);
+
+    free(sdata);
+    lrpt_qpsk_data_free(data);
+    lrpt_dsp_deinterleaver_deinit(deintlv);
+}
+
+START_TEST(test_exec_sync) {
+    /* clean stream loses only the last block which has no room for the sync lookahead */
+    const size_t clean_len = exec_stream(make_stream(0, 1), 70);
+
+    ck_assert_int_eq(clean_len, (TEST_blocks - 1) * (TEST_block_len - 8) / 2);
+
+    /* a few damaged sync words are bridged by lookahead at any threshold */
+    ck_assert_int_eq(exec_stream(make_stream(3, 50), 70), clean_len);
+    ck_assert_int_eq(exec_stream(make_stream(3, 50), 100), clean_len);
+
+    /* one inverted bit per sync word gives exactly 75% agreement */
+    ck_assert_int_eq(exec_stream(make_stream(1, 1), 50), clean_len);
+    ck_assert_int_eq(exec_stream(make_stream(1, 1), 70), clean_len);
+    ck_assert_int_eq(exec_stream(make_stream(1, 1), 75), clean_len);
+    ck_assert_int_eq(exec_stream(make_stream(1, 1), 76), 0);
+    ck_assert_int_eq(exec_stream(make_stream(1, 1), 100), 0);
+
+    /* two inverted bits give 50% agreement */
+    ck_assert_int_eq(exec_stream(make_stream(2, 1), 50), clean_len);
+
+    /* only short spurious locks on random data are left above the threshold */
+    ck_assert_int_lt(exec_stream(make_stream(2, 1), 51), clean_len / 10);
+}
+
+Suite *deinterleaver_suite(void) {
+    Suite *s;
+    TCase *tc_alloc, *tc_param, *tc_exec;
+
+    s = suite_create("Deinterleaver");
+    tc_alloc = tcase_create("allocation/freeing");
+    tc_param = tcase_create("parameters");
+    tc_exec = tcase_create("execution");
+
+    tcase_add_test(tc_alloc, test_alloc);
+    tcase_add_test(tc_param, test_sync_thresh);
+    tcase_add_test(tc_exec, test_exec_null);
+    tcase_add_test(tc_exec, test_exec_zero);
+    tcase_add_test(tc_exec, test_exec_sparse);
+    tcase_add_test(tc_exec, test_exec_sync);
+
+    suite_add_tcase(s, tc_alloc);
+    suite_add_tcase(s, tc_param);
+    suite_add_tcase(s, tc_exec);
+
+    return s;
+}
+
+int main(void) {
+    int num_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = deinterleaver_suite();
+    sr = srunner_create(s);
+
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_run_all(sr, CK_NORMAL);
+    num_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
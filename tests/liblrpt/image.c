@@ -0,0 +1,216 @@
+/*
+ * This file is part of liblrpt.
+ *
+ * liblrpt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liblrpt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liblrpt. If not, see https://www.gnu.org/licenses/
+ *
+ * Author: Viktor Drobot
+ */
+
+/*************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <check.h>
+
+#include "liblrpt/image.h"
+
+/*************************************************************************************************/
+
+static const size_t TEST_width = 1568; /* Width of Meteor-M2 channel */
+static const size_t TEST_height = 64;
+
+/*************************************************************************************************/
+
+static bool is_zero(const uint8_t *p, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        if (p[i] != 0)
+            return false;
+
+    return true;
+}
+
+/*************************************************************************************************/
+
+START_TEST(test_add_channel) {
+    lrpt_error_t *err = lrpt_error_init();
+    lrpt_image_t *image = lrpt_image_alloc_sparse(0, TEST_height, err);
+
+    ck_assert_ptr_nonnull(err);
+    ck_assert_ptr_nonnull(image);
+    ck_assert(image->sparse);
+    ck_assert_int_eq(lrpt_image_width(image), 0);
+    ck_assert_int_eq(lrpt_image_height(image), TEST_height);
+
+    /* Nothing is allocated for empty image */
+    ck_assert(lrpt_image_add_channel(image, 65, err));
+
+    for (uint8_t i = 0; i < 6; i++)
+        ck_assert_ptr_null(image->channels[i]);
+
+    /* Resizing doesn't allocate absent channels */
+    ck_assert(lrpt_image_set_width(image, TEST_width, err));
+
+    for (uint8_t i = 0; i < 6; i++)
+        ck_assert_ptr_null(image->channels[i]);
+
+    /* Only requested channels are allocated, zero-filled */
+    ck_assert(lrpt_image_add_channel(image, 65, err));
+    ck_assert(lrpt_image_add_channel(image, 68, err));
+
+    for (uint8_t i = 0; i < 6; i++) {
+        if ((i == 1) || (i == 4)) {
+            ck_assert_ptr_nonnull(image->channels[i]);
+            ck_assert(is_zero(image->channels[i], TEST_width * TEST_height));
+        }
+        else
+            ck_assert_ptr_null(image->channels[i]);
+    }
+
+    /* Present channel is kept as is */
+    uint8_t *chan = image->channels[1];
+
+    lrpt_image_set_px(image, 65, 10, 0xAB);
+    ck_assert(lrpt_image_add_channel(image, 65, err));
+    ck_assert_ptr_eq(image->channels[1], chan);
+    ck_assert_int_eq(lrpt_image_get_px(image, 65, 10), 0xAB);
+
+    /* Absent channels read as zeroes and ignore writes */
+    lrpt_image_set_px(image, 66, 10, 0xAB);
+    ck_assert_ptr_null(image->channels[2]);
+    ck_assert_int_eq(lrpt_image_get_px(image, 66, 10), 0);
+
+    /* Wrong APIDs */
+    ck_assert(!lrpt_image_add_channel(image, 63, err));
+    ck_assert_int_eq(lrpt_error_code(err), LRPT_ERR_CODE_PARAM);
+    ck_assert(!lrpt_image_add_channel(image, 70, err));
+    ck_assert_int_eq(lrpt_error_code(err), LRPT_ERR_CODE_PARAM);
+    ck_assert(!lrpt_image_add_channel(NULL, 65, err));
+
+    lrpt_image_free(image);
+    lrpt_error_deinit(err);
+}
+
+START_TEST(test_set_height) {
+    lrpt_image_t *image = lrpt_image_alloc_sparse(TEST_width, TEST_height, NULL);
+    const size_t size = (TEST_width * TEST_height);
+
+    ck_assert_ptr_nonnull(image);
+    ck_assert(lrpt_image_add_channel(image, 64, NULL));
+    ck_assert(lrpt_image_add_channel(image, 69, NULL));
+
+    memset(image->channels[0], 0x11, size);
+    memset(image->channels[5], 0x55, size);
+
+    /* Shrink and grow back, grown rows should be zeroed whatever was left there */
+    ck_assert(lrpt_image_set_height(image, TEST_height / 2, NULL));
+    ck_assert(lrpt_image_set_height(image, 4 * TEST_height, NULL));
+    ck_assert_int_eq(lrpt_image_height(image), 4 * TEST_height);
+
+    for (uint8_t i = 0; i < 6; i++) {
+        if ((i == 0) || (i == 5)) {
+            const uint8_t *p = image->channels[i];
+            const uint8_t v = ((i == 0) ? 0x11 : 0x55);
+
+            ck_assert_ptr_nonnull(p);
+
+            for (size_t j = 0; j < (size / 2); j++)
+                ck_assert_int_eq(p[j], v);
+
+            ck_assert(is_zero(p + size / 2, 4 * size - size / 2));
+        }
+        else
+            ck_assert_ptr_null(image->channels[i]);
+    }
+
+    /* Channel added after resize has full size */
+    ck_assert(lrpt_image_add_channel(image, 66, NULL));
+    ck_assert_ptr_nonnull(image->channels[2]);
+    ck_assert(is_zero(image->channels[2], 4 * size));
+    lrpt_image_set_px(image, 66, 4 * size - 1, 0xAB);
+    ck_assert_int_eq(lrpt_image_get_px(image, 66, 4 * size - 1), 0xAB);
+
+    /* Zero height frees everything */
+    ck_assert(lrpt_image_set_height(image, 0, NULL));
+
+    for (uint8_t i = 0; i < 6; i++)
+        ck_assert_ptr_null(image->channels[i]);
+
+    lrpt_image_free(image);
+}
+
+START_TEST(test_dense) {
+    lrpt_image_t *image = lrpt_image_alloc(TEST_width, TEST_height, NULL);
+
+    ck_assert_ptr_nonnull(image);
+    ck_assert(!image->sparse);
+
+    /* Plain image has all channels right away */
+    for (uint8_t i = 0; i < 6; i++) {
+        ck_assert_ptr_nonnull(image->channels[i]);
+        ck_assert(is_zero(image->channels[i], TEST_width * TEST_height));
+    }
+
+    ck_assert(lrpt_image_set_height(image, 2 * TEST_height, NULL));
+
+    for (uint8_t i = 0; i < 6; i++) {
+        ck_assert_ptr_nonnull(image->channels[i]);
+        ck_assert(is_zero(image->channels[i], 2 * TEST_width * TEST_height));
+    }
+
+    /* Missing channel means corrupted plain image */
+    uint8_t *chan = image->channels[3];
+
+    image->channels[3] = NULL;
+    ck_assert(!lrpt_image_set_height(image, TEST_height, NULL));
+    image->channels[3] = chan;
+
+    lrpt_image_free(image);
+}
+
+Suite *image_suite(void) {
+    Suite *s;
+    TCase *tc_sparse, *tc_dense;
+
+    s = suite_create("Image");
+    tc_sparse = tcase_create("sparse image");
+    tc_dense = tcase_create("plain image");
+
+    tcase_add_test(tc_sparse, test_add_channel);
+    tcase_add_test(tc_sparse, test_set_height);
+    tcase_add_test(tc_dense, test_dense);
+
+    suite_add_tcase(s, tc_sparse);
+    suite_add_tcase(s, tc_dense);
+
+    return s;
+}
+
+int main(void) {
+    int num_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = image_suite();
+    sr = srunner_create(s);
+
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_run_all(sr, CK_NORMAL);
+    num_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}